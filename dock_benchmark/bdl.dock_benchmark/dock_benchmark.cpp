@@ -0,0 +1,331 @@
+/**************************************************************************************
+**
+** Copyright (C) 2016 Bernhard Steiner
+**
+** This file is part of the styled_qt_controls library
+**
+** This product is licensed under the GNU General Public License version 3.
+** The license is as published by the Free Software Foundation published at
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** Alternatively, this product is licensed under the GNU Lesser General Public
+** License version 3 for non-commercial use. The license is as published by the
+** Free Software Foundation published at https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** Feel free to contact us if you have any questions about licensing or want
+** to use the library in a commercial closed source product.
+**
+**************************************************************************************/
+
+#include <bdl.styled_qt_controls\styled_qt_controls.hpp>
+#include <QtTest\QtTest>
+
+#include "dock_benchmark.q.hpp"
+
+using namespace bdl::dock_benchmark;
+using namespace bdl::styled_qt_controls;
+using namespace bdl::styled_qt_controls::util;
+
+//Number of query points per axis for the widget_at benchmark
+#define WIDGET_AT_SAMPLES 16
+//Number of tabs per dock widget for the benchmarks over the dock widget count
+#define TREE_TABS_PER_WIDGET 4
+
+bool benchmark_widget_factory::defer_content() const
+{
+	return true;
+}
+QWidget* benchmark_widget_factory::create_content(settings_group* group)
+{
+	return new QWidget();
+}
+
+void dock_benchmark::add_tab_rows()
+{
+	QTest::addColumn<int>("tabs");
+
+	for (int tabs : { 1, 4, 16, 64, 256, 1024 })
+		QTest::newRow(qPrintable(QString("N=%1").arg(tabs))) << tabs;
+}
+void dock_benchmark::add_widget_rows()
+{
+	QTest::addColumn<int>("widgets");
+
+	for (int widgets : { 1, 4, 16, 64, 256 })
+		QTest::newRow(qPrintable(QString("M=%1").arg(widgets))) << widgets;
+}
+
+styled_dock_widget* dock_benchmark::create_dock_widget(styled_dock_splitter* parent, int tabs, bool deferred)
+{
+	auto dock_widget = new styled_dock_widget(styled_dock_orientation::top, &m_factory);
+	parent->addWidget(dock_widget);
+
+	styled_dock_widget::begin_transaction();
+	for (int i = 0; i < tabs; i++)
+	{
+		QString title = "tab " + QString::number(i);
+		if (deferred)
+			dock_widget->add_item(new styled_dock_item(title, &m_factory, new settings_group("content", { { "payload", QString::number(i) } })));
+		else
+			dock_widget->add_item(new styled_dock_item(title, new QWidget()));
+	}
+	styled_dock_widget::commit_transaction();
+
+	return dock_widget;
+}
+styled_dock_splitter* dock_benchmark::create_dock_tree(int widgets, int tabs, QVector<styled_dock_widget*>* dock_widgets)
+{
+	//The dock widgets are spread over a grid of vertical splitters, so the tree has a second level like a typical window layout
+	int columns = qCeil(qSqrt(widgets));
+	auto root = new styled_dock_splitter(Qt::Horizontal, &m_factory);
+
+	styled_dock_splitter* column = nullptr;
+	for (int i = 0; i < widgets; i++)
+	{
+		if (i % columns == 0)
+		{
+			column = new styled_dock_splitter(Qt::Vertical, &m_factory);
+			root->addWidget(column);
+		}
+
+		auto dock_widget = create_dock_widget(column, tabs, true);
+		if (dock_widgets != nullptr)
+			dock_widgets->push_back(dock_widget);
+	}
+
+	return root;
+}
+styled_dock_widget* dock_benchmark::show_dock_widget(styled_dock_splitter* host, int tabs)
+{
+	auto dock_widget = create_dock_widget(host, tabs, false);
+
+	host->resize(1200, 800);
+	host->show();
+	QTest::qWaitForWindowExposed(host);
+
+	return dock_widget;
+}
+
+void dock_benchmark::add_items_data()
+{
+	add_tab_rows();
+}
+void dock_benchmark::add_items()
+{
+	QFETCH(int, tabs);
+
+	styled_dock_splitter host(Qt::Horizontal, &m_factory);
+	show_dock_widget(&host, 0);
+
+	//Fills a new dock widget with N tabs, one add_item call per tab. Creating the dock widget and the items and deleting them is
+	//not part of the measurement, so the runs are timed by hand instead of with QBENCHMARK
+	int runs = qMax(1, 1024 / tabs);
+	qint64 elapsed = 0;
+	QElapsedTimer timer;
+
+	for (int run = 0; run < runs; run++)
+	{
+		auto dock_widget = new styled_dock_widget(styled_dock_orientation::top, &m_factory);
+		host.addWidget(dock_widget);
+
+		QList<styled_dock_item*> items;
+		for (int i = 0; i < tabs; i++)
+			items.push_back(new styled_dock_item("tab " + QString::number(i), new QWidget()));
+
+		timer.start();
+		for (auto item : items)
+			dock_widget->add_item(item);
+		elapsed += timer.nsecsElapsed();
+
+		delete dock_widget;
+	}
+
+	QTest::setBenchmarkResult((qreal)elapsed / runs, QTest::WalltimeNanoseconds);
+}
+
+void dock_benchmark::add_remove_item_data()
+{
+	add_tab_rows();
+}
+void dock_benchmark::add_remove_item()
+{
+	QFETCH(int, tabs);
+
+	styled_dock_splitter host(Qt::Horizontal, &m_factory);
+	auto dock_widget = show_dock_widget(&host, tabs);
+	styled_dock_item item("extra", new QWidget());
+
+	QBENCHMARK
+	{
+		dock_widget->add_item(&item);
+		dock_widget->remove_item(&item);
+	}
+}
+
+void dock_benchmark::select_data()
+{
+	add_tab_rows();
+}
+void dock_benchmark::select()
+{
+	QFETCH(int, tabs);
+
+	styled_dock_splitter host(Qt::Horizontal, &m_factory);
+	auto dock_widget = show_dock_widget(&host, tabs);
+
+	//Alternates between the first and the last tab, so the selected tab has to be moved into the visible tabs when they overflow
+	int idx = 0;
+	QBENCHMARK
+	{
+		idx = tabs - 1 - idx;
+		dock_widget->select(idx);
+	}
+}
+
+void dock_benchmark::tabs_changed_data()
+{
+	add_tab_rows();
+}
+void dock_benchmark::tabs_changed()
+{
+	QFETCH(int, tabs);
+
+	styled_dock_splitter host(Qt::Horizontal, &m_factory);
+	auto layout = show_dock_widget(&host, tabs)->findChild<styled_dock_layout*>();
+	QVERIFY(layout != nullptr);
+
+	QBENCHMARK
+	{
+		layout->tabs_changed();
+	}
+}
+
+void dock_benchmark::layout_set_geometry_data()
+{
+	add_tab_rows();
+}
+void dock_benchmark::layout_set_geometry()
+{
+	QFETCH(int, tabs);
+
+	styled_dock_splitter host(Qt::Horizontal, &m_factory);
+	auto layout = show_dock_widget(&host, tabs)->findChild<styled_dock_layout*>();
+	QVERIFY(layout != nullptr);
+
+	//Alternates between the full and the half width, so the visible tabs are placed again on every call
+	QRect wide = layout->geometry();
+	QRect narrow(wide.topLeft(), QSize(wide.width() / 2, wide.height()));
+	bool is_narrow = false;
+	QBENCHMARK
+	{
+		is_narrow = !is_narrow;
+		layout->setGeometry(is_narrow ? narrow : wide);
+	}
+}
+
+void dock_benchmark::target_index_build_data()
+{
+	add_widget_rows();
+}
+void dock_benchmark::target_index_build()
+{
+	QFETCH(int, widgets);
+
+	QVector<styled_dock_widget*> dock_widgets;
+	std::unique_ptr<styled_dock_splitter> root(create_dock_tree(widgets, 1, &dock_widgets));
+	root->resize(1600, 1200);
+	root->show();
+	QVERIFY(QTest::qWaitForWindowExposed(root.get()));
+
+	dock_target_index index;
+	QBENCHMARK
+	{
+		index.build(dock_widgets);
+	}
+}
+
+void dock_benchmark::widget_at_data()
+{
+	add_widget_rows();
+}
+void dock_benchmark::widget_at()
+{
+	QFETCH(int, widgets);
+
+	QVector<styled_dock_widget*> dock_widgets;
+	std::unique_ptr<styled_dock_splitter> root(create_dock_tree(widgets, 1, &dock_widgets));
+	root->resize(1600, 1200);
+	root->show();
+	QVERIFY(QTest::qWaitForWindowExposed(root.get()));
+
+	dock_target_index index;
+	index.build(dock_widgets);
+
+	//The query points are spread over the whole window, like the cursor positions of a drag
+	QRect area(root->mapToGlobal(QPoint(0, 0)), root->size());
+	QVector<QPoint> points;
+	for (int y = 0; y < WIDGET_AT_SAMPLES; y++)
+	{
+		for (int x = 0; x < WIDGET_AT_SAMPLES; x++)
+			points.push_back(QPoint(area.left() + (2 * x + 1) * area.width() / (2 * WIDGET_AT_SAMPLES), area.top() + (2 * y + 1) * area.height() / (2 * WIDGET_AT_SAMPLES)));
+	}
+
+	int hits = 0;
+	QBENCHMARK
+	{
+		for (auto& point : points)
+		{
+			if (index.widget_at(point) != nullptr)
+				hits++;
+		}
+	}
+	QVERIFY(hits > 0);
+}
+
+void dock_benchmark::settings_round_trip_data()
+{
+	add_widget_rows();
+}
+void dock_benchmark::settings_round_trip()
+{
+	QFETCH(int, widgets);
+
+	std::unique_ptr<styled_dock_splitter> source(create_dock_tree(widgets, TREE_TABS_PER_WIDGET, nullptr));
+
+	{
+		std::unique_ptr<settings_group> group(source->save_settings());
+		styled_dock_splitter target(Qt::Horizontal, &m_factory);
+		target.load_settings(group.get());
+		QCOMPARE(target.findChildren<styled_dock_widget*>().count(), widgets);
+	}
+
+	QBENCHMARK
+	{
+		std::unique_ptr<settings_group> group(source->save_settings());
+		styled_dock_splitter target(Qt::Horizontal, &m_factory);
+		target.load_settings(group.get());
+	}
+}
+
+void dock_benchmark::layout_round_trip_data()
+{
+	add_widget_rows();
+}
+void dock_benchmark::layout_round_trip()
+{
+	QFETCH(int, widgets);
+
+	std::unique_ptr<styled_dock_splitter> source(create_dock_tree(widgets, TREE_TABS_PER_WIDGET, nullptr));
+
+	{
+		styled_dock_splitter target(Qt::Horizontal, &m_factory);
+		QVERIFY(target.load_layout(source->save_layout()));
+		QCOMPARE(target.findChildren<styled_dock_widget*>().count(), widgets);
+	}
+
+	QBENCHMARK
+	{
+		styled_dock_splitter target(Qt::Horizontal, &m_factory);
+		target.load_layout(source->save_layout());
+	}
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+/**************************************************************************************
+**
+** Copyright (C) 2016 Bernhard Steiner
+**
+** This file is part of the styled_qt_controls library
+**
+** This product is licensed under the GNU General Public License version 3.
+** The license is as published by the Free Software Foundation published at
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** Alternatively, this product is licensed under the GNU Lesser General Public
+** License version 3 for non-commercial use. The license is as published by the
+** Free Software Foundation published at https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** Feel free to contact us if you have any questions about licensing or want
+** to use the library in a commercial closed source product.
+**
+**************************************************************************************/
+
+#pragma once
+
+#include <bdl.styled_qt_controls\styled_qt_controls.hpp>
+
+namespace bdl
+{
+	namespace dock_benchmark
+	{
+		/*! \brief Widget factory for the benchmark items. The content is deferred, so restoring settings does not measure the content creation
+		 *
+		 * \author bdl
+		 */
+		class benchmark_widget_factory : public styled_qt_controls::base_widget_factory
+		{
+		public:
+			virtual bool defer_content() const override;
+			virtual QWidget* create_content(styled_qt_controls::util::settings_group* group) override;
+		};
+
+		/*! \brief Benchmarks of the dock widget subsystem. Every benchmark is data driven over the number of tabs (N) or dock widgets (M),
+		 * so running it with a csv logger ("-o results.csv,csv") gives the scaling curves
+		 *
+		 * \author bdl
+		 */
+		class dock_benchmark : public QObject
+		{
+			Q_OBJECT;
+
+		private:
+			benchmark_widget_factory m_factory;
+
+			void add_tab_rows();
+			void add_widget_rows();
+
+			styled_qt_controls::styled_dock_widget* create_dock_widget(styled_qt_controls::styled_dock_splitter* parent, int tabs, bool deferred);
+			styled_qt_controls::styled_dock_splitter* create_dock_tree(int widgets, int tabs, QVector<styled_qt_controls::styled_dock_widget*>* dock_widgets);
+			styled_qt_controls::styled_dock_widget* show_dock_widget(styled_qt_controls::styled_dock_splitter* host, int tabs);
+
+		private slots:
+			void add_items_data();
+			void add_items();
+			void add_remove_item_data();
+			void add_remove_item();
+			void select_data();
+			void select();
+			void tabs_changed_data();
+			void tabs_changed();
+			void layout_set_geometry_data();
+			void layout_set_geometry();
+			void target_index_build_data();
+			void target_index_build();
+			void widget_at_data();
+			void widget_at();
+			void settings_round_trip_data();
+			void settings_round_trip();
+			void layout_round_trip_data();
+			void layout_round_trip();
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,40 @@
+/**************************************************************************************
+**
+** Copyright (C) 2016 Bernhard Steiner
+**
+** This file is part of the styled_qt_controls library
+**
+** This product is licensed under the GNU General Public License version 3.
+** The license is as published by the Free Software Foundation published at
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** Alternatively, this product is licensed under the GNU Lesser General Public
+** License version 3 for non-commercial use. The license is as published by the
+** Free Software Foundation published at https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** Feel free to contact us if you have any questions about licensing or want
+** to use the library in a commercial closed source product.
+**
+**************************************************************************************/
+
+#include <bdl.styled_qt_controls\styled_qt_controls.hpp>
+#include <QtTest\QtTest>
+
+#include "dock_benchmark.q.hpp"
+
+#pragma comment(lib, "Qt5Test.lib")
+
+using namespace bdl::dock_benchmark;
+
+int main(int argc, char* argv[])
+{
+	//The benchmarks do not need a visible window. The platform can still be overridden with -platform or QT_QPA_PLATFORM
+	if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+		qputenv("QT_QPA_PLATFORM", "offscreen");
+
+	QApplication app(argc, argv);
+	app.setAttribute(Qt::AA_DontCreateNativeWidgetSiblings, true);
+
+	dock_benchmark benchmark;
+	return QTest::qExec(&benchmark, argc, argv);
+}
\ No newline at end of file
@@ -29,6 +29,9 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
 	QApplication app(__argc, __argv);
 	app.setAttribute(Qt::AA_DontCreateNativeWidgetSiblings, true);
 
+	//The precompiled theme is created by the library build and copied by post_build.cmd
+	util::style_loader::load_theme(QCoreApplication::applicationDirPath() + "/themes/dark_orange.sqtt");
+
 	auto* window = new main_window();
 	window->show();
 
@@ -15,4 +15,6 @@ IF not exist %2"imageformats" (mkdir %2"imageformats")
 xcopy %1"qt\plugins\imageformats\*.dll" %2imageformats /d /y 1> nul
 
 
-xcopy %1"bin/styled_qt_controls.x64."%4"\*.dll" %2 /d /s /y 1> nul
\ No newline at end of file
+xcopy %1"bin/styled_qt_controls.x64."%4"\*.dll" %2 /d /s /y 1> nul
+IF not exist %2"themes" (mkdir %2"themes")
+xcopy %1"bin/styled_qt_controls.x64."%4"\themes\*.sqtt" %2themes /d /y 1> nul
\ No newline at end of file
@@ -58,7 +58,7 @@ styled_color_picker::styled_color_picker(const QString& title, QWidget* pick_wid
 	title_layout->addWidget(title_label, 0, 0);
 	
 	style_loader loader(":/styled_color_picker/styled_color_picker.qss");
-	this->setStyleSheet(loader.style_string());
+	loader.apply_to(this);
 
 	QGridLayout* color_box_layout = new QGridLayout();
 	color_box_layout->setSpacing(0);
@@ -66,7 +66,8 @@ styled_color_picker::styled_color_picker(const QString& title, QWidget* pick_wid
 	color_box_layout->setColumnStretch(0, 1);
 
 	m_color_display_frame = new styled_frame();
-	m_color_display_frame->setStyleSheet("background: solid red; border: 1px solid " + style_loader::color_to_text(theme_colors::border) + ";");
+	m_color_display_frame->setObjectName("part_scp_color_display");
+	m_color_display_frame->setStyleSheet("background: solid red;");
 	m_color_display_frame->setFixedHeight(18);
 	color_box_layout->addWidget(m_color_display_frame, 0, 0);
 
@@ -298,7 +299,8 @@ void styled_color_picker::color_changed_internal(const QColor& color)
 
 	m_hs_picker->color(color);
 	m_l_picker->color(color);
-	m_color_display_frame->setStyleSheet("background: solid " + style_loader::color_to_text(color) + "; border: 1px solid " + style_loader::color_to_text(theme_colors::border) + ";");
+	//Only the background is set here, the border comes from styled_color_picker.qss so it follows theme changes
+	m_color_display_frame->setStyleSheet("background: solid " + style_loader::color_to_text(color) + ";");
 
 	switch ((color_pick_mode)m_color_mode_group->checkedId())
 	{
@@ -21,6 +21,8 @@
 #include "styled_collapse_widget.q.hpp"
 
 #include "..\util\style_loader.hpp"
+#include "..\util\theme_style.hpp"
+#include "..\util\trace_profiler.hpp"
 #include "styled_frame.q.hpp"
 #include "styled_gradient_frame.q.hpp"
 
@@ -120,10 +122,13 @@ void styled_collapse_widget::content_widget(QWidget* const & widget)
 
 void styled_collapse_widget::paintEvent(QPaintEvent *pe)
 {
+	trace_scope scope(trace_profiler::first_paint(this) ? "first paint" : nullptr, this);
+
 	QStyleOption o;
 	o.initFrom(this);
 	QPainter p(this);
-	style()->drawPrimitive(QStyle::PE_Widget, &o, &p, this);
+	if (!theme_style::draw_widget(&o, &p, this))
+		style()->drawPrimitive(QStyle::PE_Widget, &o, &p, this);
 }
 
 
@@ -19,8 +19,11 @@
 
 #include <bdl.styled_qt_controls\styled_qt_controls.hpp>
 #include "styled_frame.q.hpp"
+#include "..\util\theme_style.hpp"
+#include "..\util\trace_profiler.hpp"
 
 using namespace bdl::styled_qt_controls;
+using namespace bdl::styled_qt_controls::util;
 
 styled_frame::styled_frame(QWidget* parent, Qt::WindowFlags f) : QFrame(parent, f), m_topline_color(0, 0, 0, 0), m_hover(false), m_selected(false), m_inner_padding_top(1),
 	m_inner_padding_side(1), m_custom_data_1(false)
@@ -46,10 +49,13 @@ void styled_frame::mouseMoveEvent(QMouseEvent* event)
 }
 void styled_frame::paintEvent(QPaintEvent *pe)
 {
+	trace_scope scope(trace_profiler::first_paint(this) ? "first paint" : nullptr, this);
+
 	QStyleOption o;
 	o.initFrom(this);
 	QPainter p(this);
-	style()->drawPrimitive(QStyle::PE_Widget, &o, &p, this);
+	if (!theme_style::draw_widget(&o, &p, this))
+		style()->drawPrimitive(QStyle::PE_Widget, &o, &p, this);
 
 	QPen topLinePen(m_topline_color);
 	p.setPen(topLinePen);
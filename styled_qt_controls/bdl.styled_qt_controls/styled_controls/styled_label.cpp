@@ -19,18 +19,24 @@
 
 #include <bdl.styled_qt_controls\styled_qt_controls.hpp>
 #include "styled_label.q.hpp"
+#include "..\util\theme_style.hpp"
+#include "..\util\trace_profiler.hpp"
 
 using namespace bdl::styled_qt_controls;
+using namespace bdl::styled_qt_controls::util;
 
 styled_label::styled_label(const QString& text) : QLabel(text), m_selected(false) { }
 styled_label::~styled_label() { }
 
 void styled_label::paintEvent(QPaintEvent *pe)
 {
+	trace_scope scope(trace_profiler::first_paint(this) ? "first paint" : nullptr, this);
+
 	QStyleOption o;
 	o.initFrom(this);
 	QPainter p(this);
-	style()->drawPrimitive(QStyle::PE_Widget, &o, &p, this);
+	if (!theme_style::draw_widget(&o, &p, this))
+		style()->drawPrimitive(QStyle::PE_Widget, &o, &p, this);
 
 	QLabel::paintEvent(pe);
 }
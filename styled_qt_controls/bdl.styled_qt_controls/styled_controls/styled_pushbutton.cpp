@@ -19,12 +19,15 @@
 
 #include <bdl.styled_qt_controls\styled_qt_controls.hpp>
 #include "styled_pushbutton.q.hpp"
+#include "..\util\theme_style.hpp"
+#include "..\util\trace_profiler.hpp"
 
 #include <QtWidgets\QStyleOptionButton>
 #include <QtWidgets\qdrawutil.h>
 #include <QtWidgets\qproxystyle.h>
 
 using namespace bdl::styled_qt_controls;
+using namespace bdl::styled_qt_controls::util;
 
 styled_pushbutton::styled_pushbutton(QWidget* parent) : QPushButton(parent), m_hover(false), m_parent_hover(false), m_selected(false), m_topline_color(0, 0, 0, 0), m_inner_border_color(0, 0, 0, 0), m_pressed(false), m_custom_data_1(false) { init(); }
 styled_pushbutton::styled_pushbutton(const QString& text, QWidget* parent) : QPushButton(text, parent), m_hover(false), m_parent_hover(false), m_selected(false), m_topline_color(0, 0, 0, 0), m_inner_border_color(0, 0, 0, 0), m_pressed(false), m_custom_data_1(false) { init(); }
@@ -46,12 +49,18 @@ void styled_pushbutton::init()
 
 void styled_pushbutton::paintEvent(QPaintEvent *pe)
 {
+	trace_scope scope(trace_profiler::first_paint(this) ? "first paint" : nullptr, this);
+
 	QStyleOption o;
 	o.initFrom(this);
 	QPainter p(this);
-	style()->drawPrimitive(QStyle::PE_Widget, &o, &p, this);
+	bool themed = theme_style::draw_widget(&o, &p, this);
+	if (!themed)
+		style()->drawPrimitive(QStyle::PE_Widget, &o, &p, this);
 
-	QPushButton::paintEvent(pe);
+	//The stylesheet would paint the bevel of the button a second time, with the look it had when the button was last polished
+	if (!themed || !theme_style::paints_completely(this))
+		QPushButton::paintEvent(pe);
 
 	QStyleOptionButton btn;
 	initStyleOption(&btn);
@@ -97,8 +106,7 @@ void styled_pushbutton::this_released()
 }
 void styled_pushbutton::this_toggled(bool checked)
 {
-	style()->unpolish(this);
-	style()->polish(this);
+	style_state::changed(this, "checked", !checked);
 }
 void styled_pushbutton::menu_aboutToHide()
 {
@@ -126,9 +134,10 @@ void styled_pushbutton::inner_border_color(QColor value)
 
 void styled_pushbutton::custom_data_1(const bool& value)
 {
+	if (m_custom_data_1 == value)
+		return;
 	m_custom_data_1 = value;
-	style()->unpolish(this);
-	style()->polish(this);
+	style_state::changed(this, "custom_data_1", !value);
 }
 
 QSize styled_pushbutton::sizeHint() const
@@ -19,8 +19,11 @@
 
 #include <bdl.styled_qt_controls\styled_qt_controls.hpp>
 #include "styled_widget.q.hpp"
+#include "..\util\theme_style.hpp"
+#include "..\util\trace_profiler.hpp"
 
 using namespace bdl::styled_qt_controls;
+using namespace bdl::styled_qt_controls::util;
 
 styled_widget::styled_widget(QWidget* parent, Qt::WindowFlags f) : QWidget(parent, f), m_topline_color(0, 0, 0, 0), m_hover(false) { }
 styled_widget::~styled_widget() { }
@@ -48,10 +51,13 @@ void styled_widget::mouseDoubleClickEvent(QMouseEvent * event)
 }
 void styled_widget::paintEvent(QPaintEvent *pe)
 {
+	trace_scope scope(trace_profiler::first_paint(this) ? "first paint" : nullptr, this);
+
 	QStyleOption o;
 	o.initFrom(this);
 	QPainter p(this);
-	style()->drawPrimitive(QStyle::PE_Widget, &o, &p, this);
+	if (!theme_style::draw_widget(&o, &p, this))
+		style()->drawPrimitive(QStyle::PE_Widget, &o, &p, this);
 
 	QPen topLinePen(m_topline_color);
 	p.setPen(topLinePen);
@@ -60,14 +66,16 @@ void styled_widget::paintEvent(QPaintEvent *pe)
 void styled_widget::enterEvent(QEvent * event)
 {
 	QWidget::enterEvent(event);
+	if (m_hover)
+		return;
 	this->setProperty("hover", true);
-	style()->unpolish(this);
-	style()->polish(this);
+	style_state::changed(this, "hover", false);
 }
 void styled_widget::leaveEvent(QEvent * event)
 {
 	QWidget::leaveEvent(event);
+	if (!m_hover)
+		return;
 	this->setProperty("hover", false);
-	style()->unpolish(this);
-	style()->polish(this);
+	style_state::changed(this, "hover", true);
 }
\ No newline at end of file
@@ -30,7 +30,7 @@ using namespace bdl::styled_qt_controls::util;
 tree_combobox::tree_combobox(QWidget* parent) : QFrame(parent)
 {
 	style_loader loader(":/styled_controls/tree_combobox.qss");
-	this->setStyleSheet(loader.style_string());
+	loader.apply_to(this);
 	this->setMouseTracking(true);
 
 	m_tree_view = new styled_tree_view();
@@ -24,3 +24,23 @@ using namespace bdl::styled_qt_controls;
 using namespace bdl::styled_qt_controls::util;
 
 void base_widget_factory::load(styled_dock_widget* parent, util::settings_group* group) { }
+bool base_widget_factory::defer_content() const
+{
+	return false;
+}
+QWidget* base_widget_factory::create_content(util::settings_group* group)
+{
+	return nullptr;
+}
+bool base_widget_factory::async_content() const
+{
+	return false;
+}
+QVariant base_widget_factory::load_content_data(const util::settings_group* group)
+{
+	return QVariant();
+}
+QWidget* base_widget_factory::create_content_from_data(util::settings_group* group, const QVariant& data)
+{
+	return create_content(group);
+}
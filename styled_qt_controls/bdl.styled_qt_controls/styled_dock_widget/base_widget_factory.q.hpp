@@ -46,6 +46,51 @@ public:
 	 * \param group The settings group from which the item should be constructed
 	 */
 	virtual void load(styled_dock_widget* parent, util::settings_group* group);
+
+	/*! \brief Returns whether items should be restored deferred
+	 *
+	 * When true, styled_dock_widget::load_settings doesn't call load but creates deferred styled_dock_items that only store their
+	 * title and settings. The content of an item is created with create_content when it is selected the first time.
+	 * The default implementation returns false.
+	 *
+	 * \returns True when the content should be created deferred, False otherwise
+	 */
+	virtual bool defer_content() const;
+	/*! \brief Creates the content widget of a deferred styled_dock_item
+	 *
+	 * The default implementation returns nullptr.
+	 *
+	 * \param group The settings group of the item
+	 * \returns The content widget
+	 */
+	virtual QWidget* create_content(util::settings_group* group);
+
+	/*! \brief Returns whether the content of deferred items is created in two steps
+	 *
+	 * When true, styled_dock_item::create_content calls load_content_data on a worker thread and creates the widget afterwards
+	 * with create_content_from_data on the GUI thread. The dock widget shows a placeholder in the meantime.
+	 * The factory must outlive all pending loads. The default implementation returns false.
+	 *
+	 * \returns True when the content data should be loaded asynchronously, False otherwise
+	 */
+	virtual bool async_content() const;
+	/*! \brief Loads the data a deferred item needs for its content. Is called on a worker thread and must not access widgets
+	 *
+	 * The default implementation returns an invalid QVariant.
+	 *
+	 * \param group A copy of the settings group of the item
+	 * \returns The data that is passed to create_content_from_data
+	 */
+	virtual QVariant load_content_data(const util::settings_group* group);
+	/*! \brief Creates the content widget of a deferred styled_dock_item from the data returned by load_content_data
+	 *
+	 * The default implementation calls create_content.
+	 *
+	 * \param group The settings group of the item
+	 * \param data The data returned by load_content_data
+	 * \returns The content widget
+	 */
+	virtual QWidget* create_content_from_data(util::settings_group* group, const QVariant& data);
 };
 
 END_BDL_SQTC
\ No newline at end of file
@@ -0,0 +1,148 @@
+/**************************************************************************************
+**
+** Copyright (C) 2016 Bernhard Steiner
+**
+** This file is part of the styled_qt_controls library
+**
+** This product is licensed under the GNU General Public License version 3.
+** The license is as published by the Free Software Foundation published at
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** Alternatively, this product is licensed under the GNU Lesser General Public
+** License version 3 for non-commercial use. The license is as published by the
+** Free Software Foundation published at https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** Feel free to contact us if you have any questions about licensing or want
+** to use the library in a commercial closed source product.
+**
+**************************************************************************************/
+
+
+#include <bdl.styled_qt_controls\styled_qt_controls.hpp>
+#include "dock_target_index.hpp"
+#include "styled_dock_widget.q.hpp"
+#include "../util/trace_profiler.hpp"
+
+using namespace bdl::styled_qt_controls;
+using namespace bdl::styled_qt_controls::util;
+
+void dock_target_index::build(const QVector<styled_dock_widget*>& front_to_back_widgets)
+{
+	trace_scope scope("dock_target_index::build");
+
+	clear();
+
+	for (auto widget : front_to_back_widgets)
+	{
+		if (!widget->isVisible())
+			continue;
+
+		QRect rect(widget->mapToGlobal(QPoint(0, 0)), widget->size());
+		m_rects.push_back(rect);
+		m_widgets.push_back(widget);
+		m_edges.push_back(rect.left());
+		m_edges.push_back(rect.left() + rect.width());
+	}
+
+	std::sort(m_edges.begin(), m_edges.end());
+	m_edges.erase(std::unique(m_edges.begin(), m_edges.end()), m_edges.end());
+
+	build_slabs();
+}
+void dock_target_index::clear()
+{
+	m_rects.clear();
+	m_widgets.clear();
+	m_edges.clear();
+	m_slabs.clear();
+	m_columns.clear();
+}
+void dock_target_index::remove(styled_dock_widget* widget)
+{
+	int idx = m_widgets.indexOf(widget);
+	if (idx == -1)
+		return;
+
+	//The widgets behind the removed one become visible, the rectangles are kept from the last build
+	m_widgets[idx] = nullptr;
+	build_slabs();
+}
+
+styled_dock_widget* dock_target_index::widget_at(const QPoint& global_pos) const
+{
+	trace_scope scope("dock_target_index::widget_at");
+
+	int slab = std::upper_bound(m_edges.begin(), m_edges.end(), global_pos.x()) - m_edges.begin() - 1;
+	if (slab < 0 || slab >= m_slabs.count())
+		return nullptr;
+
+	auto& col = m_columns[m_slabs[slab]];
+	int row = std::upper_bound(col.edges.begin(), col.edges.end(), global_pos.y()) - col.edges.begin() - 1;
+	if (row < 0 || row >= col.owners.count() || col.owners[row] == -1)
+		return nullptr;
+
+	return m_widgets[col.owners[row]];
+}
+
+void dock_target_index::build_slabs()
+{
+	m_slabs.clear();
+	m_columns.clear();
+
+	//Slab i covers the x range [m_edges[i], m_edges[i + 1])
+	for (int slab = 0; slab + 1 < m_edges.count(); slab++)
+	{
+		int left = m_edges[slab];
+		column col;
+
+		QVector<int> overlapping;
+		for (int i = 0; i < m_rects.count(); i++)
+		{
+			if (m_widgets[i] != nullptr && m_rects[i].left() <= left && left < m_rects[i].left() + m_rects[i].width())
+			{
+				overlapping.push_back(i);
+				col.edges.push_back(m_rects[i].top());
+				col.edges.push_back(m_rects[i].top() + m_rects[i].height());
+			}
+		}
+
+		std::sort(col.edges.begin(), col.edges.end());
+		col.edges.erase(std::unique(col.edges.begin(), col.edges.end()), col.edges.end());
+		col.owners.fill(-1, max(col.edges.count() - 1, 0));
+
+		//Widgets are visited front to back, so a row keeps the first widget that covers it
+		for (auto i : overlapping)
+		{
+			int first = std::lower_bound(col.edges.begin(), col.edges.end(), m_rects[i].top()) - col.edges.begin();
+			int last = std::lower_bound(col.edges.begin(), col.edges.end(), m_rects[i].top() + m_rects[i].height()) - col.edges.begin();
+
+			for (int row = first; row < last; row++)
+			{
+				if (col.owners[row] == -1)
+					col.owners[row] = i;
+			}
+		}
+
+		//Neighbouring rows of the same widget are merged
+		column merged;
+		for (int row = 0; row < col.owners.count(); row++)
+		{
+			if (!merged.owners.isEmpty() && merged.owners.last() == col.owners[row])
+				continue;
+
+			merged.edges.push_back(col.edges[row]);
+			merged.owners.push_back(col.owners[row]);
+		}
+		if (!col.edges.isEmpty())
+			merged.edges.push_back(col.edges.last());
+
+		if (!m_columns.isEmpty() && m_columns.last().edges == merged.edges && m_columns.last().owners == merged.owners)
+		{
+			m_slabs.push_back(m_columns.count() - 1);
+			continue;
+		}
+
+		m_slabs.push_back(m_columns.count());
+		m_columns.push_back(merged);
+	}
+}
\ No newline at end of file
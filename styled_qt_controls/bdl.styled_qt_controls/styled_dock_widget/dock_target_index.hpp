@@ -0,0 +1,80 @@
+/**************************************************************************************
+**
+** Copyright (C) 2016 Bernhard Steiner
+**
+** This file is part of the styled_qt_controls library
+**
+** This product is licensed under the GNU General Public License version 3.
+** The license is as published by the Free Software Foundation published at
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** Alternatively, this product is licensed under the GNU Lesser General Public
+** License version 3 for non-commercial use. The license is as published by the
+** Free Software Foundation published at https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** Feel free to contact us if you have any questions about licensing or want
+** to use the library in a commercial closed source product.
+**
+**************************************************************************************/
+
+
+#pragma once
+
+#include "../styled_qt_controls.hpp"
+
+BEGIN_BDL_SQTC
+
+class styled_dock_widget;
+
+/*! \brief Spatial index of the styled_dock_widgets that can be a target of a drop
+	*
+	* \author bdl
+	*
+	* The index stores the global rectangles of the widgets at the time it was built. The x axis is split into slabs at every
+	* left and right edge, each slab is split into rows at the top and bottom edges of the widgets overlapping it. Every row stores the
+	* front most widget covering it, so a lookup is a binary search for the slab followed by a binary search for the row. Neighbouring
+	* slabs with the same rows share them, which keeps the index small for docked widgets that tile their windows.
+	*/
+class BDL_SQTC_EXPORT dock_target_index
+{
+public:
+	/*! \brief Builds the index
+		*
+		* \param front_to_back_widgets The widgets that can be hit, the front most widget first
+		*/
+	void build(const QVector<styled_dock_widget*>& front_to_back_widgets);
+	/*! \brief Removes all widgets from the index
+		*/
+	void clear();
+	/*! \brief Removes a single widget from the index (required when a widget is destroyed while the index is in use)
+		*
+		* \param widget The widget to remove
+		*/
+	void remove(styled_dock_widget* widget);
+
+	/*! \brief Returns the front most widget at a position
+		*
+		* \param global_pos Position in global coordinates
+		* \returns The front most widget at global_pos or nullptr when there is no widget at this position
+		*/
+	styled_dock_widget* widget_at(const QPoint& global_pos) const;
+
+private:
+	struct column
+	{
+		//! Row i covers the y range [edges[i], edges[i + 1])
+		QVector<int> edges;
+		//! Index of the front most widget in each row, -1 for rows without a widget
+		QVector<int> owners;
+	};
+
+	void build_slabs();
+
+	QVector<QRect> m_rects;
+	QVector<styled_dock_widget*> m_widgets;
+	QVector<int> m_edges;
+	QVector<int> m_slabs;
+	QVector<column> m_columns;
+};
+
+END_BDL_SQTC
\ No newline at end of file
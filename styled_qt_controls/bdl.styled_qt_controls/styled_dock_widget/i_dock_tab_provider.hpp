@@ -0,0 +1,65 @@
+/**************************************************************************************
+**
+** Copyright (C) 2016 Bernhard Steiner
+**
+** This file is part of the styled_qt_controls library
+**
+** This product is licensed under the GNU General Public License version 3.
+** The license is as published by the Free Software Foundation published at
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** Alternatively, this product is licensed under the GNU Lesser General Public
+** License version 3 for non-commercial use. The license is as published by the
+** Free Software Foundation published at https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** Feel free to contact us if you have any questions about licensing or want
+** to use the library in a commercial closed source product.
+**
+**************************************************************************************/
+
+
+#pragma once
+
+#include "../styled_qt_controls.hpp"
+
+BEGIN_BDL_SQTC
+
+/*! \brief Interface for a class that supplies the tabs of a styled_dock_layout
+	*
+	* \author bdl
+	*
+	* Widgets are only requested for the tabs that fit into the layout, all other tabs are described by their size hint.
+	* This keeps the number of widgets constant, no matter how many tabs there are.
+	*/
+class BDL_SQTC_EXPORT i_dock_tab_provider
+{
+public:
+	/*! \brief Releases all data associated with an instance of the i_dock_tab_provider class
+		*/
+	virtual ~i_dock_tab_provider() { }
+
+	/*! \brief Implement this method to return the number of tabs
+		*
+		* \returns The number of tabs
+		*/
+	virtual int tab_count() = 0;
+	/*! \brief Implement this method to return the size of a tab without creating a widget for it
+		*
+		* \param idx Index of the tab
+		* \returns The size hint of the tab
+		*/
+	virtual QSize tab_size_hint(int idx) = 0;
+	/*! \brief Implement this method to return the widget that displays a tab. The widget has to be visible
+		*
+		* \param idx Index of the tab
+		* \returns The widget that displays the tab
+		*/
+	virtual QWidget* bind_tab(int idx) = 0;
+	/*! \brief Implement this method to release the widgets of all tabs that are not visible
+		*
+		* \param visible_count Number of tabs (starting at index 0) that are visible
+		*/
+	virtual void release_tabs(int visible_count) = 0;
+};
+
+END_BDL_SQTC
\ No newline at end of file
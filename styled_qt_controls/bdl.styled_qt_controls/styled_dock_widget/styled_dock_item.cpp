@@ -20,15 +20,25 @@
 #include <bdl.styled_qt_controls\styled_qt_controls.hpp>
 #include "styled_dock_item.q.hpp"
 #include "styled_dock_widget.q.hpp"
+#include "base_widget_factory.q.hpp"
+#include "../util/settings/settings_group.hpp"
+#include "../util/async_task.q.hpp"
 
 using namespace bdl::styled_qt_controls;
+using namespace bdl::styled_qt_controls::util;
 
-styled_dock_item::styled_dock_item(const QString& title, QWidget* content) : m_title(title), m_content(content), m_parent(nullptr)
+styled_dock_item::styled_dock_item(const QString& title, QWidget* content) : m_title(title), m_content(content), m_parent(nullptr), m_is_suspended(false),
+	m_factory(nullptr), m_settings(nullptr), m_content_loading(false)
+{ }
+styled_dock_item::styled_dock_item(const QString& title, base_widget_factory* factory, settings_group* settings) : m_title(title), m_content(nullptr), m_parent(nullptr),
+	m_is_suspended(false), m_factory(factory), m_settings(settings), m_content_loading(false)
 { }
 styled_dock_item::~styled_dock_item()
 { 
 	if (m_content != nullptr)
 		delete m_content;
+
+	delete m_settings;
 }
 
 void styled_dock_item::select()
@@ -43,8 +53,72 @@ void styled_dock_item::title(const QString& value)
 	emit title_changed(this);
 }
 
+void styled_dock_item::suspend(bool value)
+{
+	if (m_is_suspended == value)
+		return;
+
+	m_is_suspended = value;
+	if (m_is_suspended)
+		emit suspended();
+	else
+		emit resumed();
+}
+
 void styled_dock_item::close()
 {
 	if (m_parent != nullptr)
 		m_parent->remove_item(this);
+}
+
+bool styled_dock_item::deferred() const
+{
+	return m_content == nullptr;
+}
+settings_group* styled_dock_item::deferred_settings() const
+{
+	return m_settings;
+}
+void styled_dock_item::create_content()
+{
+	if (m_content != nullptr || m_content_loading)
+		return;
+
+	if (m_factory != nullptr && m_factory->async_content())
+	{
+		//The worker gets its own copy, the item may be saved or closed while the data is loading
+		base_widget_factory* factory = m_factory;
+		settings_group* group = m_settings != nullptr ? m_settings->clone() : nullptr;
+
+		m_content_loading = true;
+		connect(async_task::run([factory, group]()
+		{
+			QVariant data = factory->load_content_data(group);
+			delete group;
+			return data;
+		}), &async_task::finished, this, &styled_dock_item::content_data_loaded);
+		return;
+	}
+
+	content_ready(m_factory != nullptr ? m_factory->create_content(m_settings) : nullptr);
+}
+void styled_dock_item::content_data_loaded(QVariant data)
+{
+	m_content_loading = false;
+	content_ready(m_factory->create_content_from_data(m_settings, data));
+}
+void styled_dock_item::content_ready(QWidget* content)
+{
+	m_content = content;
+
+	if (m_content == nullptr)
+	{
+		qWarning() << "styled_dock_item: The factory didn't create a content for the deferred item" << m_title;
+		m_content = new QWidget();
+	}
+
+	delete m_settings;
+	m_settings = nullptr;
+
+	emit content_created(this);
 }
\ No newline at end of file
@@ -24,6 +24,8 @@
 BEGIN_BDL_SQTC
 
 class styled_dock_widget;
+class base_widget_factory;
+namespace util { class settings_group; }
 
 /*! \brief A item for the styled_dock_widget
 	*
@@ -35,10 +37,16 @@ class BDL_SQTC_EXPORT styled_dock_item : public QObject
 
 	//! The title of the item. This text is displayed in the tab and in the header bar
 	PROPERTY2(QString, title, GET_CONST_REF, SET_PT);
-	//! Content widget of the item
+	//! Content widget of the item. Is nullptr for a deferred item until the content has been created
 	PROPERTY1(QWidget*, content, GET);
 	//! The container to which this item belongs
 	PROPERTY2(styled_dock_widget*, parent, GET, SET);
+	//! True while the item is not visible, either because it is not selected or because its dock widget is hidden or minimized
+	PROPERTY1(bool, is_suspended, GET);
+
+	PROPERTY0(base_widget_factory*, factory);
+	PROPERTY0(util::settings_group*, settings);
+	PROPERTY0(bool, content_loading);
 
 public:
 	/*! \brief Initializes a new instance of the styled_dock_widget class
@@ -47,6 +55,13 @@ public:
 		* \param content The content widget
 		*/
 	styled_dock_item(const QString& title, QWidget* content);
+	/*! \brief Initializes a new deferred instance of the styled_dock_item class. The content is created by the factory when it is needed the first time
+		*
+		* \param title The string that should be displayed in the tab
+		* \param factory The factory that creates the content (see base_widget_factory::create_content)
+		* \param settings The settings from which the content is created. The item takes ownership
+		*/
+	styled_dock_item(const QString& title, base_widget_factory* factory, util::settings_group* settings);
 	/*! \brief Releases all data associated with an instance of the styled_dock_widget class
 		*/
 	~styled_dock_item();
@@ -58,6 +73,28 @@ public:
 		*/
 	void close();
 
+	/*! \brief Returns whether the content of the item has not been created yet
+		*
+		* \returns True when the item is deferred, False otherwise
+		*/
+	bool deferred() const;
+	/*! \brief Returns the settings from which a deferred item creates its content
+		*
+		* \returns The settings of the item, nullptr when the item is not deferred
+		*/
+	util::settings_group* deferred_settings() const;
+	/*! \brief Creates the content of a deferred item. Does nothing when the content already exists or is being loaded
+		*
+		* When the factory loads its content asynchronously (see base_widget_factory::async_content), the method returns immediately
+		* and content_created is emitted once the content exists.
+		*/
+	void create_content();
+	/*! \brief Suspends or resumes the item and emits suspended or resumed when the state changes. Is called by the parent styled_dock_widget
+		*
+		* \param value True when the item is not visible anymore, False when it became visible
+		*/
+	void suspend(bool value);
+
 signals:
 	/*! \brief Is emitted when the item is going to be closed
 		*
@@ -82,6 +119,23 @@ signals:
 	/*! \brief Is emitted when the item gets selected
 		*/
 	void selected();
+	/*! \brief Is emitted when the item becomes invisible. Panels can stop timers and background updates until resumed is emitted
+		*/
+	void suspended();
+	/*! \brief Is emitted when a suspended item becomes visible again
+		*/
+	void resumed();
+	/*! \brief Is emitted when the content of a deferred item has been created
+		*
+		* \param item The item that's content has been created
+		*/
+	void content_created(bdl::styled_qt_controls::styled_dock_item* item);
+
+private slots:
+	void content_data_loaded(QVariant data);
+
+private:
+	void content_ready(QWidget* content);
 };
 
 END_BDL_SQTC
\ No newline at end of file
@@ -19,10 +19,12 @@
 
 #include <bdl.styled_qt_controls\styled_qt_controls.hpp>
 #include "styled_dock_layout.q.hpp"
+#include "../util/trace_profiler.hpp"
 
 using namespace bdl::styled_qt_controls;
+using namespace bdl::styled_qt_controls::util;
 
-styled_dock_layout::styled_dock_layout() : QLayout() { }
+styled_dock_layout::styled_dock_layout() : QLayout(), m_provider(nullptr), m_visible_count(0), m_update_depth(0), m_geometry_pending(false), m_overflow(false) { }
 styled_dock_layout::~styled_dock_layout()
 {
 	clear();
@@ -32,7 +34,7 @@ styled_dock_layout::~styled_dock_layout()
 void styled_dock_layout::addItem(QLayoutItem* _item)
 {
 	m_list.append(_item);
-	setGeometry(geometry());
+	update_geometry();
 }
 QLayoutItem* styled_dock_layout::itemAt(int _idx) const
 {
@@ -53,7 +55,8 @@ QLayoutItem* styled_dock_layout::takeAt(int _idx)
 	if (_idx >= 0 && _idx < m_list.size())
 	{
 		auto item = m_list.takeAt(_idx);
-		setGeometry(geometry());
+		m_item_sizes.remove(item);
+		update_geometry();
 		return item;
 	}
 
@@ -67,81 +70,184 @@ int styled_dock_layout::count() const
 void styled_dock_layout::swap(int i, int j)
 {
 	m_list.swap(i, j);
-	setGeometry(geometry());
+	update_geometry();
+}
+void styled_dock_layout::tabs_changed()
+{
+	//The provider caches the sizes of its tabs and discards them per tab, only the sums are calculated again
+	m_size_hint = QSize();
+	m_minimum_size = QSize();
+	QLayout::invalidate();
+	update_geometry();
+}
+void styled_dock_layout::invalidate()
+{
+	m_item_sizes.clear();
+	m_size_hint = QSize();
+	m_minimum_size = QSize();
+	QLayout::invalidate();
+}
+void styled_dock_layout::begin_update()
+{
+	m_update_depth++;
+}
+void styled_dock_layout::end_update()
+{
+	if (--m_update_depth == 0 && m_geometry_pending)
+	{
+		m_geometry_pending = false;
+		setGeometry(geometry());
+	}
+}
+void styled_dock_layout::update_geometry()
+{
+	if (m_update_depth > 0)
+		m_geometry_pending = true;
+	else
+		setGeometry(geometry());
+}
+QSize styled_dock_layout::item_size_hint(QLayoutItem* item) const
+{
+	auto it = m_item_sizes.find(item);
+	if (it != m_item_sizes.end())
+		return *it;
+
+	QSize size = item->sizeHint();
+	m_item_sizes.insert(item, size);
+	return size;
 }
 
 void styled_dock_layout::setGeometry(const QRect& _rect)
 {
+	trace_scope scope("styled_dock_layout::setGeometry");
+
 	QLayout::setGeometry(_rect);
 	bool overflow = false;
 	m_visibleItems.clear();
+	m_visible_widgets.clear();
 
 	int w = _rect.left();
 
-	bool first = true;
-	for (auto o : m_list)
+	if (m_provider != nullptr)
 	{
-		QSize size = o->sizeHint();
-		if (w + size.width() < _rect.width() || first)
+		int count = m_provider->tab_count();
+		m_visible_count = 0;
+
+		for (int i = 0; i < count; i++)
 		{
-			o->setGeometry(QRect(QPoint(w, _rect.top() + contentsMargins().top()), size));
-			m_visibleItems.push_back(o);
-			first = false;
+			QSize size = m_provider->tab_size_hint(i);
+			if (w + size.width() >= _rect.width() && i > 0)
+			{
+				overflow = true;
+				break;
+			}
+
+			m_provider->bind_tab(i)->setGeometry(QRect(QPoint(w, _rect.top() + contentsMargins().top()), size));
+			m_visible_count++;
+			w += size.width() + spacing();
 		}
-		else
+
+		m_provider->release_tabs(m_visible_count);
+	}
+	else
+	{
+		bool first = true;
+		for (auto o : m_list)
 		{
-			o->setGeometry(QRect(0, 0, 0, 0));
-			overflow = true;
+			QSize size = item_size_hint(o);
+			if (w + size.width() < _rect.width() || first)
+			{
+				o->setGeometry(QRect(QPoint(w, _rect.top() + contentsMargins().top()), size));
+				m_visibleItems.push_back(o);
+				m_visible_widgets.insert(o->widget());
+				first = false;
+			}
+			else
+			{
+				o->setGeometry(QRect(0, 0, 0, 0));
+				overflow = true;
+			}
+
+			w += size.width() + spacing();
 		}
-
-		w += size.width() + spacing();
 	}
 
-	emit overflowChanged(overflow);
+	if (overflow != m_overflow)
+	{
+		m_overflow = overflow;
+		emit overflowChanged(overflow);
+	}
 }
 QSize styled_dock_layout::sizeHint() const
 {
+	if (m_size_hint.isValid())
+		return m_size_hint;
+
 	int w = 0;
 	int h = this->minimumSize().height();
 
+	if (m_provider != nullptr)
+	{
+		int count = m_provider->tab_count();
+		for (int i = 0; i < count; i++)
+		{
+			QSize size = m_provider->tab_size_hint(i);
+			w += size.width();
+			h = max(h, size.height() + this->contentsMargins().top() + this->contentsMargins().bottom());
+		}
+	}
+
 	for (auto o : m_list)
 	{
-		QSize size = o->sizeHint();
+		QSize size = item_size_hint(o);
 		w += size.width();
 		h = max(h, size.height() + this->contentsMargins().top() + this->contentsMargins().bottom());
 	}
 
 	w = max(w, this->minimumSize().width());
 
-	return QSize(w, h);
+	m_size_hint = QSize(w, h);
+	return m_size_hint;
 }
 QSize styled_dock_layout::minimumSize() const
 {
+	if (m_minimum_size.isValid())
+		return m_minimum_size;
+
 	int h = 0;
 
+	//All tabs have the same height, so the first one is sufficient
+	if (m_provider != nullptr && m_provider->tab_count() > 0)
+		h = m_provider->tab_size_hint(0).height();
+
 	for (auto o : m_list)
 	{
-		QSize size = o->sizeHint();
+		QSize size = item_size_hint(o);
 		h = max(h, size.height());
 	}
 
-	return QSize(100, h);
+	m_minimum_size = QSize(100, h);
+	return m_minimum_size;
 }
 
 bool styled_dock_layout::isVisible(QWidget* _widget)
 {
-	for (auto o : m_visibleItems)
-		if (o->widget() == _widget)
-			return true;
-
-	return false;
+	return m_visible_widgets.contains(_widget);
+}
+bool styled_dock_layout::isVisible(int idx) const
+{
+	return idx < m_visible_count;
 }
 void styled_dock_layout::clear()
 {
+	begin_update();
+
 	QLayoutItem* item;
 	while ((item = takeAt(0)))
 	{
 		item->widget()->deleteLater();
 		delete item;
 	}
+
+	end_update();
 }
\ No newline at end of file
@@ -21,12 +21,15 @@
 
 #include "../styled_qt_controls.hpp"
 #include "../styled_controls/styled_widget.q.hpp"
+#include "i_dock_tab_provider.hpp"
 
 BEGIN_BDL_SQTC
 
 /*! \brief Layout used by the tablist of the styled_dock_widget. Items are placed horizontally next to each other. Items that would overflow the layout are hidden
 	*
 	* \author bdl
+	*
+	* When a provider is set, the layout places the tabs of the provider instead of its own items and only requests widgets for the visible tabs.
 	*/
 class BDL_SQTC_EXPORT styled_dock_layout : public QLayout
 {
@@ -34,6 +37,15 @@ class BDL_SQTC_EXPORT styled_dock_layout : public QLayout
 
 	PROPERTY0(QList<QLayoutItem*>, list);
 	PROPERTY0(QList<QLayoutItem*>, visibleItems);
+	PROPERTY0(QSet<QWidget*>, visible_widgets);
+	PROPERTY0(int, update_depth);
+	PROPERTY0(bool, geometry_pending);
+	PROPERTY0(bool, overflow);
+
+	//! Supplies the tabs of the layout. When set, added items are ignored
+	PROPERTY2(i_dock_tab_provider*, provider, GET, SET);
+	//! Number of tabs of the provider that are visible
+	PROPERTY1(int, visible_count, GET);
 
 public:
 	/*! \brief Initializes a new instance of the styled_dock_widget class
@@ -61,8 +73,25 @@ public:
 	void setGeometry(const QRect& rect);
 	//! See QLayout
 	bool isVisible(QWidget* widget);
+	/*! \brief Returns whether the tab of the provider at index idx is visible
+		*
+		* \param idx Index of the tab
+		* \returns True when the tab is visible, False when it overflows
+		*/
+	bool isVisible(int idx) const;
 	//! See QLayout
 	void clear();
+	//! See QLayout
+	void invalidate();
+
+	/*! \brief Starts a batch of structural changes. The items are only placed again by the matching end_update
+		*
+		* Calls can be nested, the layout is placed once when the outermost batch ends.
+		*/
+	void begin_update();
+	/*! \brief Ends a batch of structural changes started with begin_update and places the items when something has changed
+		*/
+	void end_update();
 
 	/*! \brief Swaps the item at index i with the one at index j
 		*
@@ -70,6 +99,11 @@ public:
 		* \param j Second index
 		*/
 	void swap(int i, int j);
+	/*! \brief Places the tabs of the provider again. Has to be called when tabs were added, removed, moved or resized
+		*
+		* The cached tab sizes of the provider are kept, a provider has to discard the sizes of the tabs that have changed itself.
+		*/
+	void tabs_changed();
 
 signals:
 	/*! \brief Emitted when the overflow state changes (when items are overflowing or when items are no longer overflowing)
@@ -77,6 +111,16 @@ signals:
 		* \param is_overflow True when the items are overflowing now, False otherwise
 		*/
 	void overflowChanged(bool is_overflow);
+
+private:
+	QSize item_size_hint(QLayoutItem* item) const;
+	void update_geometry();
+
+	//Size hints are cached, since every placement would query all items otherwise
+	typedef QHash<QLayoutItem*, QSize> item_size_hashtable;
+	mutable item_size_hashtable m_item_sizes;
+	mutable QSize m_size_hint;
+	mutable QSize m_minimum_size;
 };
 
 END_BDL_SQTC
\ No newline at end of file
@@ -32,24 +32,61 @@ using namespace bdl::styled_qt_controls::util;
 styled_dock_overlay::styled_dock_overlay(styled_dock_widget* widget) : QWidget(widget), m_mode(styled_overlay_mode::none), m_tab(nullptr), m_widget(widget)
 {
 	setAttribute(Qt::WA_TransparentForMouseEvents);
+
+	m_content_frame = m_widget->findChild<styled_frame*>("part_sdw_contentframe");
+	m_tabbar_frame = m_widget->findChild<styled_frame*>("part_sdw_tabbar");
 }
 styled_dock_overlay::~styled_dock_overlay()
 { }
 
 void styled_dock_overlay::paintEvent(QPaintEvent *pe)
 {
-	QStyleOption o;
-	o.initFrom(this);
+	if (m_mode == styled_overlay_mode::none)
+		return;
+
+	QRect tab_rect;
+	if (m_mode == styled_overlay_mode::tab && m_tab != nullptr)
+		tab_rect = map(m_tab->rect(), m_tab);
+
+	//The tab mode also depends on the position of the tab, all other modes only on the size of the overlay
+	if (m_mode == styled_overlay_mode::tab && tab_rect != m_pixmap_tab_rect)
+	{
+		m_pixmaps.remove((int)styled_overlay_mode::tab);
+		m_pixmap_tab_rect = tab_rect;
+	}
+
+	auto it = m_pixmaps.find((int)m_mode);
+	if (it == m_pixmaps.end())
+		it = m_pixmaps.insert((int)m_mode, render_pixmap(tab_rect));
+
 	QPainter p(this);
+	p.drawPixmap(0, 0, it.value());
+}
+void styled_dock_overlay::resizeEvent(QResizeEvent* event)
+{
+	QWidget::resizeEvent(event);
+	m_pixmaps.clear();
+}
+void styled_dock_overlay::hideEvent(QHideEvent* event)
+{
+	//The overlay is hidden after each drag, which also picks up changed theme colors for the next one
+	QWidget::hideEvent(event);
+	m_pixmaps.clear();
+}
+
+QPixmap styled_dock_overlay::render_pixmap(const QRect& mapped_tab_rect)
+{
+	QPixmap pixmap(size() * devicePixelRatioF());
+	pixmap.setDevicePixelRatio(devicePixelRatioF());
+	pixmap.fill(Qt::transparent);
+
+	QPainter p(&pixmap);
 
 	QColor overlay_color = QColor(theme_colors::light_highlight);
 	overlay_color.setAlpha(127);
 	QColor border_color = QColor(0, 0, 255);
 	QPen border_pen(border_color, BORDER_THICKNESS, Qt::SolidLine, Qt::SquareCap, Qt::MiterJoin);
 
-	auto content_frame = m_widget->findChild<styled_frame*>("part_sdw_contentframe");
-	auto tabbar_frame = m_widget->findChild<styled_frame*>("part_sdw_tabbar");
-
 #pragma region Tab Drawing
 	switch (m_mode)
 	{
@@ -58,13 +95,13 @@ void styled_dock_overlay::paintEvent(QPaintEvent *pe)
 		if (m_widget->orientation() == styled_dock_orientation::top)
 		{
 			//Tab area
-			auto mapped_tabbar_rect = map(tabbar_frame->rect(), tabbar_frame);
+			auto mapped_tabbar_rect = map(m_tabbar_frame->rect(), m_tabbar_frame);
 			mapped_tabbar_rect = QRect(mapped_tabbar_rect.x(), mapped_tabbar_rect.y(), mapped_tabbar_rect.width(), mapped_tabbar_rect.height());
 			QRect tab_rect = QRect(QPoint(1, mapped_tabbar_rect.height() - 20), QPoint(1, mapped_tabbar_rect.height() - 20) + QPoint(150, 20));
 
 			if (m_tab != nullptr)
 			{
-				tab_rect = map(m_tab->rect(), m_tab);
+				tab_rect = mapped_tab_rect;
 				tab_rect.setHeight(tab_rect.height() + 1);
 				tab_rect.setWidth(tab_rect.width() - 1);
 				tab_rect.setTopLeft(tab_rect.topLeft() - QPoint(1, 0));
@@ -73,7 +110,7 @@ void styled_dock_overlay::paintEvent(QPaintEvent *pe)
 			//Background
 			p.setBrush(overlay_color);
 			p.setPen(QPen(QColor(0, 0, 0, 0), 0, Qt::SolidLine, Qt::FlatCap, Qt::MiterJoin));
-			auto mapped_content_rect = map(content_frame->rect(), content_frame);
+			auto mapped_content_rect = map(m_content_frame->rect(), m_content_frame);
 			p.drawRect(mapped_content_rect);
 			if (m_tab != nullptr)
 				p.drawRect(tab_rect);
@@ -117,13 +154,13 @@ void styled_dock_overlay::paintEvent(QPaintEvent *pe)
 		else if (m_widget->orientation() == styled_dock_orientation::bottom)
 		{
 			//Tab area
-			auto mapped_tabbar_rect = map(tabbar_frame->rect(), tabbar_frame);
+			auto mapped_tabbar_rect = map(m_tabbar_frame->rect(), m_tabbar_frame);
 			mapped_tabbar_rect = QRect(QPoint(0, 0), mapped_tabbar_rect.bottomLeft());
 			QRect tab_rect = QRect(QPoint(1, mapped_tabbar_rect.height() - 20), QPoint(1, mapped_tabbar_rect.height() - 20) + QPoint(150, 20));
 
 			if (m_tab != nullptr)
 			{
-				tab_rect = map(m_tab->rect(), m_tab);
+				tab_rect = mapped_tab_rect;
 				tab_rect.setHeight(tab_rect.height() + 2);
 				tab_rect.setWidth(tab_rect.width() - 1);
 				tab_rect.setTopLeft(tab_rect.topLeft() - QPoint(1, 0));
@@ -132,7 +169,7 @@ void styled_dock_overlay::paintEvent(QPaintEvent *pe)
 			//Background
 			p.setBrush(overlay_color);
 			p.setPen(QPen(QColor(0, 0, 0, 0), 0, Qt::SolidLine, Qt::FlatCap, Qt::MiterJoin));
-			auto mapped_content_rect = map(content_frame->rect(), content_frame);
+			auto mapped_content_rect = map(m_content_frame->rect(), m_content_frame);
 			mapped_content_rect = QRect(QPoint(0, 0), mapped_content_rect.bottomRight());
 			p.drawRect(mapped_content_rect);
 			if (m_tab != nullptr)
@@ -219,6 +256,7 @@ void styled_dock_overlay::paintEvent(QPaintEvent *pe)
 
 #pragma endregion
 
+	return pixmap;
 }
 
 QRect styled_dock_overlay::map(QRect r, QWidget* from)
@@ -227,16 +265,24 @@ QRect styled_dock_overlay::map(QRect r, QWidget* from)
 }
 QPoint styled_dock_overlay::map(QPoint p, QWidget* from)
 {
-	return this->mapFromGlobal(from->mapToGlobal(p));
+	//The overlay always covers the widget, so both share the same coordinates
+	return from->mapTo(m_widget, p);
 }
 
+//The setters are called on every mouse move during a drag, so they only schedule a repaint when something changed
 void styled_dock_overlay::mode(const styled_overlay_mode& value)
 {
+	if (m_mode == value)
+		return;
+
 	m_mode = value;
-	this->repaint();
+	this->update();
 }
 void styled_dock_overlay::tab(QWidget* const & value)
 {
+	if (m_tab == value)
+		return;
+
 	m_tab = value;
-	this->repaint();
+	this->update();
 }
\ No newline at end of file
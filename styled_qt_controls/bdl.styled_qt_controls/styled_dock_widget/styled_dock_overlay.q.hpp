@@ -24,6 +24,7 @@
 BEGIN_BDL_SQTC
 
 class styled_dock_widget;
+class styled_frame;
 
 /*! \brief Overlay mode that should be displayed
 	*/
@@ -56,6 +57,13 @@ class BDL_SQTC_EXPORT styled_dock_overlay : public QWidget
 	//! The tab that should be covered (only relevant in tab mode)
 	PROPERTY2(QWidget*, tab, GET, SET_PT);
 	PROPERTY0(styled_dock_widget*, widget);
+	PROPERTY0(styled_frame*, content_frame);
+	PROPERTY0(styled_frame*, tabbar_frame);
+
+	//Rendered overlays of the current size, key is the styled_overlay_mode
+	typedef QHash<int, QPixmap> mode_pixmap_hashtable;
+	PROPERTY0(mode_pixmap_hashtable, pixmaps);
+	PROPERTY0(QRect, pixmap_tab_rect);
 
 public:
 	/*! \brief Initializes a new instance of the styled_dock_overlay class
@@ -70,8 +78,13 @@ public:
 protected:
 	//! See QWidget
 	void paintEvent(QPaintEvent *pe);
+	//! See QWidget
+	void resizeEvent(QResizeEvent* event);
+	//! See QWidget
+	void hideEvent(QHideEvent* event);
 
 private:
+	QPixmap render_pixmap(const QRect& mapped_tab_rect);
 	QRect map(QRect r, QWidget* from);
 	QPoint map(QPoint p, QWidget* from);
 };
@@ -0,0 +1,45 @@
+/**************************************************************************************
+**
+** Copyright (C) 2016 Bernhard Steiner
+**
+** This file is part of the styled_qt_controls library
+**
+** This product is licensed under the GNU General Public License version 3.
+** The license is as published by the Free Software Foundation published at
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** Alternatively, this product is licensed under the GNU Lesser General Public
+** License version 3 for non-commercial use. The license is as published by the
+** Free Software Foundation published at https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** Feel free to contact us if you have any questions about licensing or want
+** to use the library in a commercial closed source product.
+**
+**************************************************************************************/
+
+
+#include <bdl.styled_qt_controls\styled_qt_controls.hpp>
+#include "styled_dock_snapshot.hpp"
+
+using namespace bdl::styled_qt_controls;
+
+styled_dock_snapshot::styled_dock_snapshot(Qt::Orientation orientation, const QList<int>& sizes) : m_orientation(orientation), m_sizes(sizes),
+	m_parking(new QWidget())
+{ }
+styled_dock_snapshot::~styled_dock_snapshot()
+{
+	delete m_parking;
+}
+
+void styled_dock_snapshot::park(QWidget* widget)
+{
+	//The parking widget is never shown, so parked widgets are hidden without being deleted or losing their state
+	widget->setParent(m_parking);
+	m_widgets << widget;
+}
+QList<QWidget*> styled_dock_snapshot::take_widgets()
+{
+	QList<QWidget*> result = m_widgets;
+	m_widgets.clear();
+	return result;
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+/**************************************************************************************
+**
+** Copyright (C) 2016 Bernhard Steiner
+**
+** This file is part of the styled_qt_controls library
+**
+** This product is licensed under the GNU General Public License version 3.
+** The license is as published by the Free Software Foundation published at
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** Alternatively, this product is licensed under the GNU Lesser General Public
+** License version 3 for non-commercial use. The license is as published by the
+** Free Software Foundation published at https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** Feel free to contact us if you have any questions about licensing or want
+** to use the library in a commercial closed source product.
+**
+**************************************************************************************/
+
+#pragma once
+
+#include "../styled_qt_controls.hpp"
+
+BEGIN_BDL_SQTC
+
+/*! \brief A detached dock tree that is kept alive while it is not displayed
+	*
+	* \author bdl
+	*
+	* Created by styled_dock_splitter::take_snapshot. The splitters, dock widgets and items of the snapshot are parked in a hidden widget,
+	* so they can be attached again with styled_dock_splitter::restore_snapshot without creating any widget. Deleting the snapshot deletes the parked widgets.
+	*/
+class BDL_SQTC_EXPORT styled_dock_snapshot
+{
+	//! The orientation of the splitter the snapshot was taken from
+	PROPERTY1(Qt::Orientation, orientation, GET);
+	//! The sizes of the splitter the snapshot was taken from
+	PROPERTY1(QList<int>, sizes, GET_CONST_REF);
+	//! The parked widgets in the order of the splitter
+	PROPERTY1(QList<QWidget*>, widgets, GET_CONST_REF);
+
+	PROPERTY0(QWidget*, parking);
+
+public:
+	/*! \brief Initializes a new, empty instance of the styled_dock_snapshot class
+		*
+		* \param orientation The orientation of the splitter
+		* \param sizes The sizes of the splitter
+		*/
+	styled_dock_snapshot(Qt::Orientation orientation, const QList<int>& sizes);
+	/*! \brief Releases all data associated with an instance of the styled_dock_snapshot class. Parked widgets are deleted
+		*/
+	~styled_dock_snapshot();
+
+	/*! \brief Moves a widget into the hidden parking widget of the snapshot
+		*
+		* \param widget The widget to park. The snapshot takes ownership
+		*/
+	void park(QWidget* widget);
+	/*! \brief Returns the parked widgets and releases the ownership. The snapshot is empty afterwards
+		*
+		* \returns The parked widgets in the order in which they were parked
+		*/
+	QList<QWidget*> take_widgets();
+
+private:
+	styled_dock_snapshot(const styled_dock_snapshot&);
+	styled_dock_snapshot& operator=(const styled_dock_snapshot&);
+};
+
+END_BDL_SQTC
\ No newline at end of file
@@ -23,18 +23,100 @@
 #include "styled_dock_widget.q.hpp"
 #include "../util/style_loader.hpp"
 #include "../util/settings/settings_group.hpp"
+#include "../util/settings/settings_io.hpp"
+#include "../util/async_task.q.hpp"
+#include "../util/trace_profiler.hpp"
 #include "../styled_window/styled_window.q.hpp"
 
+#define RECYCLED_SPLITTER_POOL_SIZE 4
+
 using namespace bdl::styled_qt_controls;
 using namespace bdl::styled_qt_controls::util;
 
+QList<styled_dock_splitter*> styled_dock_splitter::m_recycled_splitters;
+QList<styled_dock_splitter*> styled_dock_splitter::m_pending_splitters;
+
+namespace
+{
+	const quint32 layout_magic = 0x4C545153; //"SQTL"
+	const quint32 layout_version = 1;
+	//Deeper layouts are rejected as corrupt, real dock trees are only a few levels deep
+	const int max_layout_depth = 64;
+
+	enum class layout_node : quint8
+	{
+		splitter = 0,
+		dock_widget = 1
+	};
+
+	bool is_splitter_orientation(quint8 value)
+	{
+		return value == Qt::Horizontal || value == Qt::Vertical;
+	}
+	bool is_dock_orientation(quint8 value)
+	{
+		return value == (quint8)styled_dock_orientation::top || value == (quint8)styled_dock_orientation::bottom;
+	}
+}
+
 styled_dock_splitter::styled_dock_splitter(Qt::Orientation orientation, base_widget_factory* factory, bool close_on_empty, QWidget* parent)
-	: QSplitter(orientation, parent), m_close_on_empty(close_on_empty), m_factory(factory)
+	: QSplitter(orientation, parent), m_close_on_empty(close_on_empty), m_factory(factory), m_detaching(false)
 { 
 	style_loader loader(":/styled_dock_widget/styled_dock_widget.qss");
-	this->setStyleSheet(loader.style_string());
+	loader.apply_to(this);
+}
+styled_dock_splitter::~styled_dock_splitter()
+{
+	m_recycled_splitters.removeOne(this);
+	m_pending_splitters.removeOne(this);
+}
+
+styled_dock_splitter* styled_dock_splitter::create_recycled(Qt::Orientation orientation, base_widget_factory* factory, bool close_on_empty)
+{
+	while (!m_recycled_splitters.isEmpty())
+	{
+		auto splitter = m_recycled_splitters.takeLast();
+
+		//The splitter might have been used again by its owner after it removed itself
+		if (splitter->parent() != nullptr || splitter->count() > 0)
+			continue;
+
+		splitter->setOrientation(orientation);
+		splitter->m_factory = factory;
+		splitter->m_close_on_empty = close_on_empty;
+		return splitter;
+	}
+
+	return new styled_dock_splitter(orientation, factory, close_on_empty);
+}
+void styled_dock_splitter::set_sizes(const QList<int>& sizes)
+{
+	if (!styled_dock_widget::in_transaction())
+	{
+		setSizes(sizes);
+		return;
+	}
+
+	m_pending_sizes = sizes;
+	if (!m_pending_splitters.contains(this))
+		m_pending_splitters.push_back(this);
+}
+QList<int> styled_dock_splitter::target_sizes() const
+{
+	if (m_pending_splitters.contains(const_cast<styled_dock_splitter*>(this)))
+		return m_pending_sizes;
+
+	return sizes();
+}
+void styled_dock_splitter::apply_pending_sizes()
+{
+	while (!m_pending_splitters.isEmpty())
+	{
+		auto splitter = m_pending_splitters.takeFirst();
+		splitter->setSizes(splitter->m_pending_sizes);
+		splitter->m_pending_sizes.clear();
+	}
 }
-styled_dock_splitter::~styled_dock_splitter() { }
 
 void styled_dock_splitter::paintEvent(QPaintEvent* pe)
 {
@@ -47,7 +129,7 @@ void styled_dock_splitter::childEvent(QChildEvent* _child)
 {
 	QSplitter::childEvent(_child);
 
-	if (_child->removed() && m_close_on_empty)
+	if (_child->removed() && m_close_on_empty && !m_detaching)
 	{
 		if (count() == 0)
 		{
@@ -66,12 +148,18 @@ void styled_dock_splitter::childEvent(QChildEvent* _child)
 			psplitter->insertWidget(idx, child);
 
 			this->setParent(0);
+			if (m_recycled_splitters.count() < RECYCLED_SPLITTER_POOL_SIZE)
+				m_recycled_splitters.push_back(this);
+			else
+				this->deleteLater();
 		}
 	}
 }
 
 settings_group* styled_dock_splitter::save_settings()
 {
+	trace_scope scope("styled_dock_splitter::save_settings");
+
 	settings_group* sgroup = new settings_group("styled_dock_splitter");
 	sgroup->values()["type"] = "styled_dock_splitter";
 	if (this->orientation() == Qt::Horizontal)
@@ -117,12 +205,16 @@ settings_group* styled_dock_splitter::save_settings()
 }
 void styled_dock_splitter::load_settings(settings_group* group)
 {
+	trace_scope scope("styled_dock_splitter::load_settings");
+
 	if (group->values()["type"] != "styled_dock_splitter")
 	{
 		qWarning() << "Wrong settings_group type";
 		return;
 	}
 
+	styled_dock_widget::begin_transaction();
+
 	QHash<int, QWidget*> widgets;
 
 	for (auto grp : group->groups().values())
@@ -133,7 +225,7 @@ void styled_dock_splitter::load_settings(settings_group* group)
 			if (grp->values()["orientation"] == "Horizontal")
 				orientation = Qt::Horizontal;
 
-			styled_dock_splitter* splitter = new styled_dock_splitter(orientation, m_factory, grp->values()["close_on_empty"] == "True");
+			styled_dock_splitter* splitter = create_recycled(orientation, m_factory, grp->values()["close_on_empty"] == "True");
 			widgets.insert(grp->values()["idx"].toInt(), splitter);
 			splitter->load_settings(grp);
 		}
@@ -143,7 +235,7 @@ void styled_dock_splitter::load_settings(settings_group* group)
 			if (grp->values()["orientation"] == "bottom")
 				orientation = styled_dock_orientation::bottom;
 
-			styled_dock_widget* widget = new styled_dock_widget(orientation, m_factory, grp->values()["tag"]);
+			styled_dock_widget* widget = styled_dock_widget::create_recycled(orientation, m_factory, grp->values()["tag"]);
 			widgets.insert(grp->values()["idx"].toInt(), widget);
 			widget->load_settings(grp);
 		}
@@ -166,5 +258,227 @@ void styled_dock_splitter::load_settings(settings_group* group)
 	for (auto& s : group->values()["sizes"].split(";"))
 		sizes << s.toInt();
 
-	this->setSizes(sizes);
+	this->set_sizes(sizes);
+
+	styled_dock_widget::commit_transaction();
+}
+styled_dock_snapshot* styled_dock_splitter::take_snapshot()
+{
+	auto snapshot = new styled_dock_snapshot(orientation(), sizes());
+
+	//The splitter is emptied on purpose, it must not close itself or its window
+	m_detaching = true;
+	while (count() > 0)
+		snapshot->park(widget(0));
+	m_detaching = false;
+
+	return snapshot;
+}
+void styled_dock_splitter::restore_snapshot(styled_dock_snapshot* snapshot)
+{
+	styled_dock_widget::begin_transaction();
+
+	setOrientation(snapshot->orientation());
+	for (auto w : snapshot->take_widgets())
+		addWidget(w);
+	set_sizes(snapshot->sizes());
+
+	styled_dock_widget::commit_transaction();
+
+	delete snapshot;
+}
+void styled_dock_splitter::load_settings_async(const QString& path)
+{
+	//Shared, so the parsed group is also released when the splitter is destroyed before the file has been parsed
+	auto parsed = std::make_shared<std::unique_ptr<settings_group>>();
+
+	auto task = async_task::run([path, parsed]()
+	{
+		parsed->reset(settings_io::load(path));
+		return QVariant();
+	});
+
+	QObject::connect(task, &async_task::finished, this, [this, parsed]()
+	{
+		if (*parsed != nullptr)
+			load_settings(parsed->get());
+
+		emit settings_restored(*parsed != nullptr);
+		parsed->reset();
+	});
+}
+QByteArray styled_dock_splitter::save_layout()
+{
+	trace_scope scope("styled_dock_splitter::save_layout");
+
+	QByteArray layout;
+	QDataStream stream(&layout, QIODevice::WriteOnly);
+	stream.setVersion(QDataStream::Qt_5_7);
+	stream.setByteOrder(QDataStream::LittleEndian);
+
+	stream << layout_magic << layout_version << (quint8)orientation();
+	write_layout(stream);
+
+	return layout;
+}
+bool styled_dock_splitter::load_layout(const QByteArray& layout)
+{
+	trace_scope scope("styled_dock_splitter::load_layout");
+
+	QDataStream stream(layout);
+	stream.setVersion(QDataStream::Qt_5_7);
+	stream.setByteOrder(QDataStream::LittleEndian);
+
+	quint32 magic, version;
+	quint8 orientation;
+	stream >> magic >> version >> orientation;
+
+	if (stream.status() != QDataStream::Ok || magic != layout_magic)
+	{
+		qWarning() << "styled_dock_splitter: Not a dock layout";
+		return false;
+	}
+	if (version != layout_version)
+	{
+		qWarning() << "styled_dock_splitter: Unsupported dock layout version" << version;
+		return false;
+	}
+	if (!is_splitter_orientation(orientation))
+	{
+		qWarning() << "styled_dock_splitter: Dock layout is corrupt";
+		return false;
+	}
+
+	styled_dock_widget::begin_transaction();
+
+	bool success;
+	{
+		//The tree is built below a plain widget, so a corrupt layout leaves this splitter untouched and is deleted with it
+		QWidget staging;
+		bool close_on_empty;
+		QList<QWidget*> children;
+		QList<int> child_sizes;
+		success = read_node(stream, m_factory, max_layout_depth, &staging, close_on_empty, children, child_sizes);
+
+		if (success)
+		{
+			for (auto child : children)
+				this->addWidget(child);
+
+			setOrientation((Qt::Orientation)orientation);
+			m_close_on_empty = close_on_empty;
+			set_sizes(child_sizes);
+		}
+	}
+
+	styled_dock_widget::commit_transaction();
+
+	if (!success)
+	{
+		qWarning() << "styled_dock_splitter: Dock layout is corrupt";
+		return false;
+	}
+
+	return true;
+}
+void styled_dock_splitter::write_layout(QDataStream& stream)
+{
+	QList<QWidget*> children;
+	QList<int> child_sizes;
+	auto all_sizes = sizes();
+
+	for (int i = 0; i < this->count(); i++)
+	{
+		auto ch_i = widget(i);
+		if (ISQTYPE(ch_i, styled_dock_splitter) || ISQTYPE(ch_i, styled_dock_widget))
+		{
+			children.push_back(ch_i);
+			child_sizes.push_back(all_sizes.value(i));
+		}
+		else
+			qWarning() << "Unsupported type in styled_dock_splitter. Layout is not saved";
+	}
+
+	stream << (quint8)m_close_on_empty << (quint32)children.count();
+	for (auto s : child_sizes)
+		stream << (qint32)s;
+
+	for (auto ch_i : children)
+	{
+		if (ISQTYPE(ch_i, styled_dock_splitter))
+		{
+			auto splitter = (styled_dock_splitter*)ch_i;
+			stream << (quint8)layout_node::splitter << (quint8)splitter->orientation();
+			splitter->write_layout(stream);
+		}
+		else
+		{
+			auto widget = (styled_dock_widget*)ch_i;
+			stream << (quint8)layout_node::dock_widget << (quint8)widget->orientation();
+			widget->write_layout(stream);
+		}
+	}
+}
+bool styled_dock_splitter::read_layout(QDataStream& stream, int max_depth)
+{
+	bool close_on_empty;
+	QList<QWidget*> children;
+	QList<int> child_sizes;
+	if (!read_node(stream, m_factory, max_depth, this, close_on_empty, children, child_sizes))
+		return false;
+
+	m_close_on_empty = close_on_empty;
+	for (auto child : children)
+		this->addWidget(child);
+
+	this->set_sizes(child_sizes);
+	return true;
+}
+bool styled_dock_splitter::read_node(QDataStream& stream, base_widget_factory* factory, int max_depth, QWidget* parent, bool& close_on_empty, QList<QWidget*>& children, QList<int>& child_sizes)
+{
+	quint8 close;
+	quint32 child_count;
+	stream >> close >> child_count;
+
+	for (quint32 i = 0; i < child_count && stream.status() == QDataStream::Ok; i++)
+	{
+		qint32 s;
+		stream >> s;
+		child_sizes << s;
+	}
+
+	if (stream.status() != QDataStream::Ok)
+		return false;
+
+	close_on_empty = close != 0;
+
+	for (quint32 i = 0; i < child_count; i++)
+	{
+		quint8 type, orientation;
+		stream >> type >> orientation;
+		if (stream.status() != QDataStream::Ok)
+			return false;
+
+		//Children are parented right away, so the parent deletes them when the layout turns out to be corrupt
+		if (type == (quint8)layout_node::splitter && is_splitter_orientation(orientation) && max_depth > 0)
+		{
+			auto splitter = create_recycled((Qt::Orientation)orientation, factory);
+			splitter->setParent(parent);
+			children.push_back(splitter);
+			if (!splitter->read_layout(stream, max_depth - 1))
+				return false;
+		}
+		else if (type == (quint8)layout_node::dock_widget && is_dock_orientation(orientation))
+		{
+			auto widget = styled_dock_widget::create_recycled((styled_dock_orientation)orientation, factory);
+			widget->setParent(parent);
+			children.push_back(widget);
+			if (!widget->read_layout(stream))
+				return false;
+		}
+		else
+			return false;
+	}
+
+	return true;
 }
\ No newline at end of file
@@ -22,6 +22,7 @@
 #include "../styled_qt_controls.hpp"
 #include "../util/settings/settings_group.hpp"
 #include "base_widget_factory.q.hpp"
+#include "styled_dock_snapshot.hpp"
 
 BEGIN_BDL_SQTC
 
@@ -48,6 +49,34 @@ public:
 		*/
 	virtual ~styled_dock_splitter();
 
+	/*! \brief Returns an empty splitter that was removed from the dock tree before, or a new splitter when none is available
+		*
+		* Recycled splitters are already polished, so no stylesheet has to be parsed for them.
+		*
+		* \param orientation The orientation of the splitter (see QSplitter)
+		* \param factory The factory for creating dock items that gets passed to all child dock_widgets
+		* \param close_on_empty When set to true, the splitter removes itself from the parent layout when the last child is removed
+		* \returns The splitter
+		*/
+	static styled_dock_splitter* create_recycled(Qt::Orientation orientation, base_widget_factory* factory, bool close_on_empty = false);
+
+	/*! \brief Sets the sizes of the children (see QSplitter::setSizes)
+		*
+		* Inside a dock transaction (see styled_dock_widget::begin_transaction) the sizes are applied when the transaction
+		* is committed, so the children are resized once even when the sizes are changed several times.
+		*
+		* \param sizes The sizes of the children
+		*/
+	void set_sizes(const QList<int>& sizes);
+	/*! \brief Returns the sizes of the children including sizes that have been set with set_sizes but are not applied yet
+		*
+		* \returns The sizes of the children
+		*/
+	QList<int> target_sizes() const;
+	/*! \brief Applies the sizes that have been deferred by set_sizes. Is called when the outermost dock transaction is committed
+		*/
+	static void apply_pending_sizes();
+
 	/*! \brief Saves the settings of this widget
 		*
 		* \returns The settings that should be saved
@@ -58,6 +87,53 @@ public:
 		* \param group The settings_group from which the settings should be loaded
 		*/
 	void load_settings(util::settings_group* group);
+	/*! \brief Loads the settings from a file without blocking the GUI thread while the file is read and parsed
+		*
+		* The child widgets are created on the GUI thread when the file has been parsed. Combined with a factory that defers
+		* (and asynchronously loads) the content of the items, only the visible skeleton is built before settings_restored is emitted.
+		*
+		* \param path Path to the settings file (see util::settings_io::load)
+		*/
+	void load_settings_async(const QString& path);
+
+	/*! \brief Saves the dock tree below this splitter in a compact binary form
+		*
+		* Unlike save_settings no intermediate settings_group tree is built for the splitters and dock widgets, the nodes
+		* are written in preorder. Only the settings of the items themselves are stored as settings_groups.
+		*
+		* \returns The binary layout
+		*/
+	QByteArray save_layout();
+	/*! \brief Restores a dock tree saved by save_layout
+		*
+		* The splitter is only changed when the whole layout has been read successfully.
+		*
+		* \param layout The binary layout
+		* \returns False when the layout has an unknown format or is corrupt
+		*/
+	bool load_layout(const QByteArray& layout);
+
+	/*! \brief Detaches all child splitters and dock widgets into a snapshot. The splitter is empty afterwards
+		*
+		* Together with restore_snapshot this switches between workspaces without rebuilding any widget.
+		*
+		* \returns The snapshot. The caller takes ownership
+		*/
+	styled_dock_snapshot* take_snapshot();
+	/*! \brief Attaches the widgets of a snapshot to this splitter and deletes the snapshot
+		*
+		* Existing children are kept, so the current workspace should be taken with take_snapshot before.
+		*
+		* \param snapshot The snapshot to restore (see take_snapshot)
+		*/
+	void restore_snapshot(styled_dock_snapshot* snapshot);
+
+signals:
+	/*! \brief Is emitted when load_settings_async has finished
+		*
+		* \param success False when the file could not be loaded
+		*/
+	void settings_restored(bool success);
 
 protected:
 	//! See QSplitter
@@ -67,6 +143,17 @@ protected:
 
 private:
 	bool m_close_on_empty;
+	bool m_detaching;
+	QList<int> m_pending_sizes;
+
+	void write_layout(QDataStream& stream);
+	bool read_layout(QDataStream& stream, int max_depth);
+	static bool read_node(QDataStream& stream, base_widget_factory* factory, int max_depth, QWidget* parent, bool& close_on_empty, QList<QWidget*>& children, QList<int>& child_sizes);
+
+	//Splitters that removed themselves from the dock tree
+	static QList<styled_dock_splitter*> m_recycled_splitters;
+	//Splitters with sizes that are applied when the dock transaction is committed
+	static QList<styled_dock_splitter*> m_pending_splitters;
 };
 
 END_BDL_SQTC
\ No newline at end of file
@@ -30,22 +30,43 @@
 #include "../util/style_loader.hpp"
 #include "../util/qt_helper_functions.hpp"
 #include "../util/settings/settings_group.hpp"
+#include "../util/settings/settings_io.hpp"
 #include "../util/settings/i_settings_provider.q.hpp"
+#include "../util/trace_profiler.hpp"
 
 #define DRAG_BORDER_MAX_AREA 200
+#define DRAG_WINDOW_POOL_SIZE 2
+#define RECYCLED_WIDGET_POOL_SIZE 4
 
 using namespace bdl::styled_qt_controls;
 using namespace bdl::styled_qt_controls::util;
 
 QList<styled_dock_widget*> styled_dock_widget::m_all_dock_widgets;
+QList<styled_dock_widget*> styled_dock_widget::m_focused_widgets;
+bool styled_dock_widget::m_focus_tracker_connected = false;
+dock_target_index styled_dock_widget::m_drop_targets;
+styled_dock_widget* styled_dock_widget::m_overlay_target = nullptr;
+QList<styled_dock_widget::pooled_drag_window> styled_dock_widget::m_drag_window_pool;
+QList<QPair<styled_dock_orientation, base_widget_factory*>> styled_dock_widget::m_pending_prewarms;
+QList<styled_dock_widget*> styled_dock_widget::m_recycled_widgets;
+int styled_dock_widget::m_transaction_depth = 0;
+QList<styled_dock_widget*> styled_dock_widget::m_transaction_widgets;
+QList<QPointer<QWidget>> styled_dock_widget::m_transaction_windows;
 
 styled_dock_widget::styled_dock_widget(styled_dock_orientation orientation, base_widget_factory* factory, const QString& tag, bool remove_on_empty) : m_orientation(orientation), m_selected_item(nullptr),
-	m_remove_on_empty(remove_on_empty), m_title_mousedown(false), m_has_focus(false), m_drag_item(nullptr), m_ignore_overflow_changed(false), m_tag(tag), m_factory(factory)
+	m_remove_on_empty(remove_on_empty), m_title_mousedown(false), m_has_focus(false), m_drag_item(nullptr), m_ignore_overflow_changed(false), m_tag(tag), m_factory(factory),
+	m_measure_tab(nullptr), m_loading(false), m_shown(false)
 {
-	QObject::connect(qApp, SIGNAL(focusChanged(QWidget*, QWidget*)), this, SLOT(application_focus_changed(QWidget*, QWidget*)));
+	//A single connection serves all dock widgets, so the focused ones are resolved only once per focus change
+	if (!m_focus_tracker_connected)
+	{
+		QObject::connect(qApp, &QApplication::focusChanged, &styled_dock_widget::application_focus_changed);
+		m_focus_tracker_connected = true;
+	}
 
 	styled_frame* part_background = new styled_frame();
 	part_background->setObjectName("part_sdw_background");
+	m_part_background = part_background;
 
 	style_loader loader(":/styled_dock_widget/styled_dock_widget.qss");
 
@@ -54,7 +75,7 @@ styled_dock_widget::styled_dock_widget(styled_dock_orientation orientation, base
 	else if (orientation == styled_dock_orientation::bottom)
 		loader.append_file(":/styled_dock_widget/styled_dock_widget_bottom.qss");
 
-	part_background->setStyleSheet(loader.style_string());
+	loader.apply_to(part_background);
 
 	m_part_tabbar = new styled_frame();
 	m_part_tabbar->setObjectName("part_sdw_tabbar");
@@ -62,6 +83,8 @@ styled_dock_widget::styled_dock_widget(styled_dock_orientation orientation, base
 	m_part_tabbar_layout = new styled_dock_layout();
 	m_part_tabbar_layout->setSpacing(0);
 	m_part_tabbar_layout->setContentsMargins(1, 2, 0, 0);
+	m_part_tabbar_layout->provider(this);
+	m_part_tabbar->installEventFilter(this);
 	QObject::connect(m_part_tabbar_layout, SIGNAL(overflowChanged(bool)), this, SLOT(tabbar_overflowChanged(bool)));
 
 	m_part_overflow_button = new styled_pushbutton();
@@ -73,6 +96,10 @@ styled_dock_widget::styled_dock_widget(styled_dock_orientation orientation, base
 	m_overflow_menu->setObjectName("part_sdw_overflow_menu");
 	m_overflow_menu->setMinimumWidth(200);
 	m_part_overflow_button->setMenu(m_overflow_menu);
+	QObject::connect(m_overflow_menu, SIGNAL(aboutToShow()), this, SLOT(overflow_menu_aboutToShow()));
+	QObject::connect(m_overflow_menu, SIGNAL(triggered(QAction*)), this, SLOT(tabbar_overflow_action_triggered(QAction*)));
+	//The actions are only needed while the menu is open. Queued, since the triggered action is activated after the menu has been hidden
+	QObject::connect(m_overflow_menu, SIGNAL(aboutToHide()), m_overflow_menu, SLOT(clear()), Qt::QueuedConnection);
 
 	QGridLayout* tabbar_grid = new QGridLayout();
 	tabbar_grid->setContentsMargins(0, 0, 4, 0);
@@ -84,11 +111,20 @@ styled_dock_widget::styled_dock_widget(styled_dock_orientation orientation, base
 
 	styled_frame* content_frame = new styled_frame();
 	content_frame->setObjectName("part_sdw_contentframe");
+	m_part_contentframe = content_frame;
 	m_content_layout = new QGridLayout();
 	m_content_layout->setContentsMargins(0, 0, 0, 0);
 	m_content_layout->setSpacing(0);
 	content_frame->setLayout(m_content_layout);
 
+	//Shown while the content of the selected item is loaded asynchronously
+	m_part_placeholder = new styled_label("Loading...");
+	m_part_placeholder->setObjectName("part_sdw_placeholder");
+	m_part_placeholder->setAlignment(Qt::AlignCenter);
+	m_part_placeholder->setVisible(false);
+	m_part_placeholder->setFocusPolicy(Qt::ClickFocus);
+	m_content_layout->addWidget(m_part_placeholder, 0, 0);
+
 	m_part_titleframe = new styled_frame();
 	m_part_titleframe->setObjectName("part_sdw_titlebar_frame");
 	m_part_titleframe->setFocusProxy(this);
@@ -109,12 +145,19 @@ styled_dock_widget::styled_dock_widget(styled_dock_orientation orientation, base
 	title_close_button->setFixedSize(16, 14);
 	title_close_button->setObjectName("part_sdw_title_closebutton");
 	title_close_button->setFocusPolicy(Qt::NoFocus);
+	m_part_title_closebutton = title_close_button;
 	QObject::connect(title_close_button, SIGNAL(clicked(bool)), this, SLOT(title_close_button_clicked(bool)));
 
 	titlebar_layout->addWidget(m_part_titlebar_label, 0, 0);
 	titlebar_layout->addWidget(title_close_button, 0, 2);
 	m_part_titleframe->setLayout(titlebar_layout);
 
+	//The orientation specific rules select on this property (required when the stylesheets of both orientations are merged)
+	m_part_tabbar->setProperty("dock_orientation", orientation_name());
+	m_part_titleframe->setProperty("dock_orientation", orientation_name());
+	m_part_titlebar_label->setProperty("dock_orientation", orientation_name());
+	title_close_button->setProperty("dock_orientation", orientation_name());
+
 	m_layout = new QGridLayout();
 	m_layout->setContentsMargins(0,0,0,0);
 	m_layout->setSpacing(0);
@@ -154,6 +197,8 @@ styled_dock_widget::styled_dock_widget(styled_dock_orientation orientation, base
 }
 styled_dock_widget::~styled_dock_widget()
 {
+	m_part_tabbar_layout->provider(nullptr);
+
 	for (auto it : m_items)
 	{
 
@@ -164,38 +209,141 @@ styled_dock_widget::~styled_dock_widget()
 	}
 
 	m_all_dock_widgets.removeAt(m_all_dock_widgets.indexOf(this));
+	m_focused_widgets.removeOne(this);
+	m_drop_targets.remove(this);
+	if (m_overlay_target == this)
+		m_overlay_target = nullptr;
+
+	for (int i = m_drag_window_pool.count() - 1; i >= 0; i--)
+		if (m_drag_window_pool[i].dock_widget == this)
+			m_drag_window_pool.removeAt(i);
+	m_recycled_widgets.removeOne(this);
+	m_transaction_widgets.removeOne(this);
 
 	delete m_overlay;
 }
 
+styled_dock_widget* styled_dock_widget::create_recycled(styled_dock_orientation orientation, base_widget_factory* factory, const QString& tag, bool remove_on_empty)
+{
+	for (int i = m_recycled_widgets.count() - 1; i >= 0; i--)
+	{
+		auto widget = m_recycled_widgets[i];
+		if (widget->m_orientation != orientation || widget->m_factory != factory)
+			continue;
+
+		m_recycled_widgets.removeAt(i);
+
+		//The widget might have been used again by its owner after it removed itself
+		if (widget->parent() != nullptr || widget->m_items.count() > 0)
+			continue;
+
+		widget->m_tag = tag;
+		widget->m_remove_on_empty = remove_on_empty;
+		widget->setObjectName(QString());
+		widget->set_focus(false);
+		return widget;
+	}
+
+	return new styled_dock_widget(orientation, factory, tag, remove_on_empty);
+}
+
 QList<styled_dock_widget*>& styled_dock_widget::all_dock_widgets()
 {
 	return m_all_dock_widgets;
 }
+void styled_dock_widget::begin_transaction()
+{
+	m_transaction_depth++;
+}
+void styled_dock_widget::commit_transaction()
+{
+	trace_scope scope("styled_dock_widget::commit_transaction");
+
+	if (m_transaction_depth == 0)
+	{
+		qWarning() << "styled_dock_widget: commit_transaction called without begin_transaction";
+		return;
+	}
+
+	if (--m_transaction_depth > 0)
+		return;
+
+	styled_dock_splitter::apply_pending_sizes();
+
+	auto widgets = m_transaction_widgets;
+	m_transaction_widgets.clear();
+	for (auto widget : widgets)
+	{
+		widget->m_part_tabbar_layout->end_update();
+		widget->show_selected_tab();
+	}
+
+	for (auto& window : m_transaction_windows)
+	{
+		if (!window.isNull())
+			window->setUpdatesEnabled(true);
+	}
+	m_transaction_windows.clear();
+}
+bool styled_dock_widget::in_transaction()
+{
+	return m_transaction_depth > 0;
+}
+void styled_dock_widget::join_transaction()
+{
+	if (m_transaction_depth == 0 || m_transaction_widgets.contains(this))
+		return;
+
+	m_transaction_widgets.push_back(this);
+	m_part_tabbar_layout->begin_update();
+
+	//Re-enabling the updates on commit schedules a single repaint of the window
+	QWidget* top_level = QWidget::window();
+	if (top_level->updatesEnabled())
+	{
+		top_level->setUpdatesEnabled(false);
+		m_transaction_windows.push_back(top_level);
+	}
+}
 
 void styled_dock_widget::add_item(styled_dock_item* item)
 {
+	trace_scope scope("styled_dock_widget::add_item");
+
+	join_transaction();
+
 	m_items.push_back(item);
+	if (!m_item_indices.isEmpty())
+		m_item_indices.insert(item, m_items.count() - 1);
 	QObject::connect(item, SIGNAL(title_changed(bdl::styled_qt_controls::styled_dock_item*)), this, SLOT(item_title_changed(bdl::styled_qt_controls::styled_dock_item*)));
+	QObject::connect(item, SIGNAL(content_created(bdl::styled_qt_controls::styled_dock_item*)), this, SLOT(item_content_created(bdl::styled_qt_controls::styled_dock_item*)));
 
-	items_changed();
+	insert_tab(item);
 
 	if (m_selected_item == nullptr)
 		select(item);
 
 	item->parent(this);
+	update_suspension(item);
 }
 void styled_dock_widget::insert_item(styled_dock_item* item, int idx)
 {
+	trace_scope scope("styled_dock_widget::insert_item");
+
+	join_transaction();
+
 	m_items.insert(idx, item);
+	m_item_indices.clear();
 	QObject::connect(item, SIGNAL(title_changed(bdl::styled_qt_controls::styled_dock_item*)), this, SLOT(item_title_changed(bdl::styled_qt_controls::styled_dock_item*)));
+	QObject::connect(item, SIGNAL(content_created(bdl::styled_qt_controls::styled_dock_item*)), this, SLOT(item_content_created(bdl::styled_qt_controls::styled_dock_item*)));
 
-	items_changed();
+	insert_tab(item);
 
 	if (m_selected_item == nullptr)
 		select(item);
 
 	item->setParent(this);
+	update_suspension(item);
 }
 void styled_dock_widget::remove_item(styled_dock_item* item)
 {
@@ -207,6 +355,8 @@ void styled_dock_widget::remove_item(int idx)
 }
 void styled_dock_widget::remove_item_internal(int idx, bool signal_closed)
 {
+	trace_scope scope("styled_dock_widget::remove_item");
+
 	auto item = m_items[idx];
 
 	bool can_close = true;
@@ -217,18 +367,37 @@ void styled_dock_widget::remove_item_internal(int idx, bool signal_closed)
 
 	if (can_close)
 	{
+		join_transaction();
+
 		QObject::disconnect(item, SIGNAL(title_changed(bdl::styled_qt_controls::styled_dock_item*)), this, SLOT(item_title_changed(bdl::styled_qt_controls::styled_dock_item*)));
+		QObject::disconnect(item, SIGNAL(content_created(bdl::styled_qt_controls::styled_dock_item*)), this, SLOT(item_content_created(bdl::styled_qt_controls::styled_dock_item*)));
 
 		m_items.removeAt(idx);
+		m_item_indices.clear();
 		item->parent(nullptr);
 
 		if (item == m_selected_item)
 			select(nullptr);
 
+		remove_tab(item);
+
 		if (m_items.count() == 0 && m_remove_on_empty)
+		{
 			this->setParent(nullptr);
-		else
-			items_changed();
+
+			//The empty widget is kept for the next drop (see create_recycled). It is neither deleted nor recycled right away, since the removal
+			//might be caused by one of its own tabs that is still handling an event
+			QTimer::singleShot(0, this, [this]()
+			{
+				if (parent() != nullptr || m_items.count() > 0 || m_recycled_widgets.contains(this))
+					return;
+
+				if (m_recycled_widgets.count() < RECYCLED_WIDGET_POOL_SIZE)
+					m_recycled_widgets.push_back(this);
+				else
+					this->deleteLater();
+			});
+		}
 
 		if (m_selected_item == nullptr && m_items.count() > 0)
 			select(0);
@@ -242,92 +411,87 @@ void styled_dock_widget::remove_item_internal(int idx, bool signal_closed)
 }
 void styled_dock_widget::remove_item_internal(styled_dock_item* item, bool signal_closed)
 {
-	int idx = 0;
-	while (m_items[idx] != item)
-		idx++;
-	remove_item_internal(idx, signal_closed);
+	int idx = index_of(item);
+	if (idx != -1)
+		remove_item_internal(idx, signal_closed);
 }
 void styled_dock_widget::select(styled_dock_item* item)
 {
-	if (item == nullptr)
-		select(-1);
-	else
-	{
-		int idx = 0;
-		while (m_items[idx] != item)
-			idx++;
-		select(idx);
-	}
+	select(item == nullptr ? -1 : index_of(item));
 }
 void styled_dock_widget::select(int idx)
 {
+	trace_scope scope("styled_dock_widget::select");
+
 	styled_dock_item* item = nullptr;
 	if (idx != -1)
 		item = m_items[idx];
 
-	if (m_selected_item != nullptr)
-	{
-		m_tabbar_widgets[m_selected_item]->selected(false);
-		m_tabbar_widgets[m_selected_item]->findChild<styled_label*>("part_sdw_tabtext")->selected(false);
-		m_tabbar_widgets[m_selected_item]->findChild<styled_pushbutton*>("part_sdw_tab_closebutton")->selected(false);
-	}
+	if (m_selected_item != nullptr && m_tabbar_widgets.contains(m_selected_item))
+		tab_selected(m_tabbar_widgets[m_selected_item], false);
 
-	if (m_selected_item != nullptr)
+	if (m_selected_item != nullptr && m_selected_item->content() != nullptr)
 		m_selected_item->content()->setVisible(false);
 
+	styled_dock_item* old_item = m_selected_item;
 	m_selected_item = item;
 
+	if (old_item != nullptr && old_item != item)
+		update_suspension(old_item);
+
 	if (item != nullptr)
 	{
-		item->content()->setVisible(true);
+		//The content of a deferred item is created when it is selected the first time (but not while restoring, since the selection changes until the settings are loaded)
+		if (item->deferred() && !m_loading)
+			item->create_content();
+
+		if (item->content() != nullptr)
+			item->content()->setVisible(true);
 		m_part_titlebar_label->setText(item->title());
 
-		if (!m_part_tabbar_layout->isVisible(m_tabbar_widgets[item]))
-		{
-			m_items.removeAt(idx);
-			m_items.push_front(item);
-			items_changed();
-		}
+		//The visible tabs are not known until the transaction is committed, the tab is moved by show_selected_tab then
+		if (!m_transaction_widgets.contains(this) && !m_part_tabbar_layout->isVisible(idx))
+			move_tab(item, 0);
 
 		emit item->selected();
+		update_suspension(item);
 	}
+	update_placeholder();
 
 	if (m_selected_item != nullptr)
 	{
-		m_tabbar_widgets[m_selected_item]->selected(true);
-		m_tabbar_widgets[m_selected_item]->findChild<styled_label*>("part_sdw_tabtext")->selected(true);
-		m_tabbar_widgets[m_selected_item]->findChild<styled_pushbutton*>("part_sdw_tab_closebutton")->selected(true);
-		this->setFocusProxy(m_selected_item->content());		
+		if (m_tabbar_widgets.contains(m_selected_item))
+			tab_selected(m_tabbar_widgets[m_selected_item], true);
+		this->setFocusProxy(m_selected_item->content() != nullptr ? m_selected_item->content() : m_part_placeholder);
 	}
 	else
 		this->setFocusProxy(nullptr);
 }
 void styled_dock_widget::swap(styled_dock_item* first, styled_dock_item* second)
 {
-	int idx_first, idx_second;
-	for (int i = 0; i < m_items.count(); i++)
-	{
-		if (m_items[i] == first)
-			idx_first = i;
-		else if (m_items[i] == second)
-			idx_second = i;
-	}
+	int idx_first = index_of(first);
+	int idx_second = index_of(second);
 
 	m_items.swap(idx_first, idx_second);
-	m_part_tabbar_layout->swap(idx_first, idx_second);
+	m_item_indices[first] = idx_second;
+	m_item_indices[second] = idx_first;
+	m_part_tabbar_layout->tabs_changed();
 }
 void styled_dock_widget::show_overlay(bool show, const QPoint& pos)
 {
-	if (m_selected_item != nullptr)
-		emit m_selected_item->overlay_changed(show);
+	if (m_overlay->isHidden() == show)
+	{
+		if (m_selected_item != nullptr)
+			emit m_selected_item->overlay_changed(show);
 
-	this->m_overlay->setVisible(show);
+		this->m_overlay->setVisible(show);
+	}
 
 	if (show)
 	{
 		int drag_border_area = min((min(this->width(), this->height()) / 4), DRAG_BORDER_MAX_AREA);
 
-		auto content_frame = this->findChild<styled_frame*>("part_sdw_contentframe");
+		auto content_frame = m_part_contentframe;
 		auto content_pt = content_frame->mapFromGlobal(QCursor::pos());
 
 		int content_border_x = min(content_pt.x(), content_frame->width() - content_pt.x());
@@ -352,7 +516,7 @@ void styled_dock_widget::show_overlay(bool show, const QPoint& pos)
 			if (!already_set)
 			{
 				if (m_items.count() > 0)
-					m_overlay->tab(m_tabbar_widgets[m_items.last()]);
+					m_overlay->tab(m_tabbar_widgets.value(m_items[m_part_tabbar_layout->visible_count() - 1]));
 				else
 					m_overlay->tab(nullptr);
 			}
@@ -362,7 +526,7 @@ void styled_dock_widget::show_overlay(bool show, const QPoint& pos)
 		{
 			m_overlay->mode(styled_overlay_mode::tab);
 			if (this->m_items.count() > 0)
-				m_overlay->tab(m_tabbar_widgets[this->m_items.first()]);
+				m_overlay->tab(m_tabbar_widgets.value(this->m_items.first()));
 			else
 				m_overlay->tab(nullptr);
 		}
@@ -391,23 +555,27 @@ void styled_dock_widget::show_overlay(bool show, const QPoint& pos)
 }
 void styled_dock_widget::drop_item(const QList<styled_dock_item*>& items, styled_dock_orientation preferred_orientation)
 {
+	trace_scope scope("styled_dock_widget::drop_item");
+
 	auto mode = m_overlay->mode();
 	m_overlay->mode(styled_overlay_mode::none);
 
+	//All items, tabs and splitter sizes are placed once when the transaction is committed
+	begin_transaction();
+
 	switch (mode)
 	{
 	case styled_overlay_mode::tab:
 		{
 			int idx = 0;
 			if (m_overlay->tab() != nullptr)
-				idx = m_items.indexOf(m_widget_to_item[(styled_frame*)m_overlay->tab()]);
+				idx = index_of(m_widget_to_item[(styled_frame*)m_overlay->tab()]);
 
 			for (auto item : items)
 			{
 				insert_item(item, idx);
 				idx++;
 			}
-			items_changed();
 			select(items.first());
 		}
 		break;
@@ -421,12 +589,12 @@ void styled_dock_widget::drop_item(const QList<styled_dock_item*>& items, styled
 			{		
 				if (split->orientation() != Qt::Horizontal)
 				{
-					auto sizes = split->sizes();
-					styled_dock_splitter* new_splitter = new styled_dock_splitter(Qt::Horizontal, m_factory);
+					auto sizes = split->target_sizes();
+					styled_dock_splitter* new_splitter = styled_dock_splitter::create_recycled(Qt::Horizontal, m_factory);
 					split->insertWidget(insert_idx, new_splitter);
 					new_splitter->addWidget(this);
 					insert_idx = 0;
-					split->setSizes(sizes);
+					split->set_sizes(sizes);
 					split = new_splitter;
 				}
 
@@ -434,17 +602,16 @@ void styled_dock_widget::drop_item(const QList<styled_dock_item*>& items, styled
 				if (mode == styled_overlay_mode::right)
 					insert_idx++;
 
-				auto sizes = split->sizes();
+				auto sizes = split->target_sizes();
 				sizes[old_idx] = sizes[old_idx] / 2;
 				sizes.insert(old_idx, sizes[old_idx]);
-				styled_dock_widget* new_widget = new styled_dock_widget(preferred_orientation, m_factory, "", true);
+				styled_dock_widget* new_widget = create_recycled(preferred_orientation, m_factory, "", true);
 				split->insertWidget(insert_idx, new_widget);
-				split->setSizes(sizes);
+				split->set_sizes(sizes);
 
 				for (auto item : items)
 					new_widget->add_item(item);
 
-				new_widget->items_changed();
 				new_widget->select(items.first());
 			}
 			else
@@ -461,12 +628,12 @@ void styled_dock_widget::drop_item(const QList<styled_dock_item*>& items, styled
 		{
 			if (split->orientation() != Qt::Vertical)
 			{
-				auto sizes = split->sizes();
-				styled_dock_splitter* new_splitter = new styled_dock_splitter(Qt::Vertical, m_factory);
+				auto sizes = split->target_sizes();
+				styled_dock_splitter* new_splitter = styled_dock_splitter::create_recycled(Qt::Vertical, m_factory);
 				split->insertWidget(insert_idx, new_splitter);
 				new_splitter->addWidget(this);
 				insert_idx = 0;
-				split->setSizes(sizes);
+				split->set_sizes(sizes);
 				split = new_splitter;
 			}
 
@@ -474,17 +641,16 @@ void styled_dock_widget::drop_item(const QList<styled_dock_item*>& items, styled
 			if (mode == styled_overlay_mode::bottom)
 				insert_idx++;
 
-			auto sizes = split->sizes();
+			auto sizes = split->target_sizes();
 			sizes[old_idx] = sizes[old_idx] / 2;
 			sizes.insert(old_idx, sizes[old_idx]);
-			styled_dock_widget* new_widget = new styled_dock_widget(preferred_orientation, m_factory, "", true);
+			styled_dock_widget* new_widget = create_recycled(preferred_orientation, m_factory, "", true);
 			split->insertWidget(insert_idx, new_widget);
-			split->setSizes(sizes);
+			split->set_sizes(sizes);
 
 			for (auto item : items)
 				new_widget->add_item(item);
 
-			new_widget->items_changed();
 			new_widget->select(items.first());
 		}
 		else
@@ -492,6 +658,8 @@ void styled_dock_widget::drop_item(const QList<styled_dock_item*>& items, styled
 	}
 	break;
 	}
+
+	commit_transaction();
 }
 
 void styled_dock_widget::paintEvent(QPaintEvent *pe)
@@ -505,73 +673,188 @@ void styled_dock_widget::resizeEvent(QResizeEvent * event)
 {
 	styled_widget::resizeEvent(event);
 	m_overlay->resize(this->size());
+
+	//overflowChanged is only emitted when the overflow state changes, a smaller tabbar may hide the selected tab nonetheless
+	show_selected_tab();
 }
+void styled_dock_widget::showEvent(QShowEvent* event)
+{
+	styled_widget::showEvent(event);
 
-void styled_dock_widget::items_changed()
+	m_shown = true;
+	if (m_selected_item != nullptr)
+		update_suspension(m_selected_item);
+}
+void styled_dock_widget::hideEvent(QHideEvent* event)
 {
-	m_ignore_overflow_changed = true;
+	styled_widget::hideEvent(event);
 
-	m_part_tabbar_layout->clear();
-	m_tabbar_widgets.clear();
-	m_widget_to_item.clear();
-	m_overflow_menu->clear();
+	m_shown = false;
+	if (m_selected_item != nullptr)
+		update_suspension(m_selected_item);
+}
 
-	if (m_items.count() > 0)
+bool styled_dock_widget::eventFilter(QObject* obj, QEvent* ev)
+{
+	//A different stylesheet may change the size of the tabs
+	if (obj == m_part_tabbar && (ev->type() == QEvent::StyleChange || ev->type() == QEvent::FontChange))
 	{
-		m_part_titleframe->setVisible(m_orientation == styled_dock_orientation::bottom);
-		m_part_tabbar->setVisible(true);
+		m_tab_sizes.clear();
+		m_part_tabbar_layout->tabs_changed();
+		show_selected_tab();
 	}
-	else
+
+	return styled_widget::eventFilter(obj, ev);
+}
+
+int styled_dock_widget::tab_count()
+{
+	return m_items.count();
+}
+QSize styled_dock_widget::tab_size_hint(int idx)
+{
+	auto item = m_items[idx];
+	auto it = m_tab_sizes.find(item);
+	if (it != m_tab_sizes.end())
+		return *it;
+
+	//All tabs are measured with the same hidden tab, so no widget is required for tabs that are never visible
+	if (m_measure_tab == nullptr)
 	{
-		m_part_titleframe->setVisible(false);
-		m_part_tabbar->setVisible(false);
+		m_measure_tab = tabbar_widget();
+		m_measure_tab->setVisible(false);
 	}
 
-	int row = 0;
-	for (auto item : m_items)
+	m_tab_labels[m_measure_tab]->setText(item->title());
+	m_measure_tab->ensurePolished();
+	m_measure_tab->layout()->invalidate();
+
+	QSize size = m_measure_tab->sizeHint();
+	m_tab_sizes.insert(item, size);
+	return size;
+}
+QWidget* styled_dock_widget::bind_tab(int idx)
+{
+	auto item = m_items[idx];
+	styled_frame* tab = m_tabbar_widgets.value(item);
+	if (tab != nullptr)
+		return tab;
+
+	if (m_tab_pool.count() > 0)
+		tab = m_tab_pool.takeLast();
+	else
+		tab = tabbar_widget();
+
+	m_tab_labels[tab]->setText(item->title());
+	tab_selected(tab, item == m_selected_item);
+	tab->custom_data_1(m_has_focus);
+	m_tab_closebuttons[tab]->custom_data_1(m_has_focus);
+
+	m_tabbar_widgets.insert(item, tab);
+	m_widget_to_item.insert(tab, item);
+
+	tab->setVisible(true);
+	return tab;
+}
+void styled_dock_widget::release_tabs(int visible_count)
+{
+	if (m_tabbar_widgets.count() <= visible_count)
+		return;
+
+	QSet<styled_dock_item*> visible_items;
+	for (int i = 0; i < visible_count; i++)
+		visible_items.insert(m_items[i]);
+
+	for (auto item : m_tabbar_widgets.keys())
 	{
-		auto widget = tabbar_widget(item);
-		m_tabbar_widgets.insert(item, widget);
-		m_widget_to_item.insert(widget, item);
-		m_part_tabbar_layout->addWidget(widget);
-
-		m_content_layout->addWidget(item->content(), row, 0);
-		row++;
-		item->content()->setVisible(false);
-
-		auto action = m_overflow_menu->addAction(item->title());
-		action->setData(qVariantFromValue((void*)item));
-		QObject::connect(action, SIGNAL(triggered(bool)), this, SLOT(tabbar_overflow_action_triggered(bool)));
+		if (!visible_items.contains(item))
+			release_tab(item);
 	}
+}
 
-	if (m_items.size() > 0)
-	{
-		select(m_selected_item);
+void styled_dock_widget::insert_tab(styled_dock_item* item)
+{
+	m_ignore_overflow_changed = true;
 
-		if (m_selected_item != nullptr && !m_part_tabbar_layout->isVisible(m_tabbar_widgets[m_selected_item]) && m_items[0] != m_selected_item)
-		{
-			auto item = m_selected_item;
-			m_items.removeAt(m_items.indexOf(item));
-			m_items.insert(0, item);
-			select(0);
-			items_changed();
-		}
-	}
-	else
-		select(nullptr);
+	if (item->content() != nullptr)
+		add_content(item);
+
+	m_part_tabbar_layout->tabs_changed();
+	update_tabbar();
 
 	m_ignore_overflow_changed = false;
+	show_selected_tab();
+}
+void styled_dock_widget::remove_tab(styled_dock_item* item)
+{
+	m_ignore_overflow_changed = true;
+
+	if (m_tabbar_widgets.contains(item))
+		release_tab(item);
+	m_tab_sizes.remove(item);
+	if (item->content() != nullptr)
+		m_content_layout->removeWidget(item->content());
+
+	m_part_tabbar_layout->tabs_changed();
+	update_tabbar();
+
+	m_ignore_overflow_changed = false;
+	show_selected_tab();
+}
+void styled_dock_widget::move_tab(styled_dock_item* item, int idx)
+{
+	int old_idx = index_of(item);
+	m_items.move(old_idx, idx);
+	m_item_indices.clear();
+	m_part_tabbar_layout->tabs_changed();
+}
+void styled_dock_widget::show_selected_tab()
+{
+	if (m_transaction_widgets.contains(this))
+		return;
+
+	if (m_selected_item != nullptr && m_items[0] != m_selected_item && !m_part_tabbar_layout->isVisible(index_of(m_selected_item)))
+		move_tab(m_selected_item, 0);
+}
+void styled_dock_widget::add_content(styled_dock_item* item)
+{
+	//Only the content of the selected item is visible, so all contents share one cell
+	m_content_layout->addWidget(item->content(), 0, 0);
+	item->content()->setVisible(item == m_selected_item);
+}
+void styled_dock_widget::update_placeholder()
+{
+	m_part_placeholder->setVisible(m_selected_item != nullptr && m_selected_item->content() == nullptr);
+}
+void styled_dock_widget::focus_item(styled_dock_item* item)
+{
+	//The content of an asynchronously loaded item doesn't exist yet, the placeholder keeps the focus until it has been created
+	if (item->content() != nullptr)
+		item->content()->setFocus(Qt::FocusReason::MouseFocusReason);
+	else
+		m_part_placeholder->setFocus(Qt::FocusReason::MouseFocusReason);
 }
-styled_frame* styled_dock_widget::tabbar_widget(styled_dock_item* item)
+void styled_dock_widget::update_suspension(styled_dock_item* item)
 {
-	styled_frame* tab = new styled_frame();
+	//Only the selected item of a shown dock widget is visible. Minimizing the window sends spontaneous hide events, so it suspends the item as well
+	item->suspend(item != m_selected_item || !m_shown);
+}
+void styled_dock_widget::update_tabbar()
+{
+	m_part_titleframe->setVisible(m_items.count() > 0 && m_orientation == styled_dock_orientation::bottom);
+	m_part_tabbar->setVisible(m_items.count() > 0);
+}
+styled_frame* styled_dock_widget::tabbar_widget()
+{
+	styled_frame* tab = new styled_frame(m_part_tabbar);
 	tab->setObjectName("part_sdw_tab");
+	tab->setProperty("dock_orientation", orientation_name());
 	QObject::connect(tab, SIGNAL(mousePressed(QMouseEvent*)), this, SLOT(tabbar_widget_mousePressed(QMouseEvent*)));
 	QObject::connect(tab, SIGNAL(mouseReleased(QMouseEvent*)), this, SLOT(tabbar_widget_mouseReleased(QMouseEvent*)));
 	QObject::connect(tab, SIGNAL(mouseMove(QMouseEvent*)), this, SLOT(tabbar_widget_mouseMove(QMouseEvent*)));
 	QObject::connect(tab, SIGNAL(hover_changed(bool)), this, SLOT(tabbar_widget_hover_changed(bool)));
 
-	styled_label* tab_label = new styled_label(item->title());
+	styled_label* tab_label = new styled_label();
 	tab_label->setObjectName("part_sdw_tabtext");
 
 	QGridLayout* tab_layout = new QGridLayout();
@@ -580,6 +863,7 @@ styled_frame* styled_dock_widget::tabbar_widget(styled_dock_item* item)
 
 	styled_pushbutton* tab_close_button = new styled_pushbutton();
 	tab_close_button->setObjectName("part_sdw_tab_closebutton");
+	tab_close_button->setProperty("dock_orientation", orientation_name());
 	tab_close_button->setFocusPolicy(Qt::NoFocus);
 	tab_close_button->setFixedSize(16, 14);
 	tab_close_button->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
@@ -594,12 +878,91 @@ styled_frame* styled_dock_widget::tabbar_widget(styled_dock_item* item)
 
 	tab_close_button->setVisible(m_orientation == styled_dock_orientation::top);
 
-	tab->custom_data_1(m_has_focus);
-	tab_close_button->custom_data_1(m_has_focus);
+	m_tab_labels.insert(tab, tab_label);
+	m_tab_closebuttons.insert(tab, tab_close_button);
 
 	return tab;
 }
+void styled_dock_widget::tab_selected(styled_frame* tab, bool selected)
+{
+	tab->selected(selected);
+	m_tab_labels[tab]->selected(selected);
+	m_tab_closebuttons[tab]->selected(selected);
+}
+void styled_dock_widget::release_tab(styled_dock_item* item)
+{
+	//The tab is only hidden, since the close button of the tab might still be emitting the signal that caused the removal
+	auto tab = m_tabbar_widgets.take(item);
+	m_widget_to_item.remove(tab);
+
+	tab->setVisible(false);
+	tab->hover(false);
+	m_tab_closebuttons[tab]->parent_hover(false);
+	m_tab_pool.push_back(tab);
+}
+int styled_dock_widget::index_of(styled_dock_item* item)
+{
+	//Reordering only clears the index, so it is rebuilt once for a series of changes instead of being updated for each of them
+	if (m_item_indices.isEmpty())
+	{
+		for (int i = 0; i < m_items.count(); i++)
+			m_item_indices.insert(m_items[i], i);
+	}
+
+	return m_item_indices.value(item, -1);
+}
+settings_group* styled_dock_widget::save_item(styled_dock_item* item, int idx)
+{
+	settings_group* item_group = nullptr;
+
+	if (item->deferred())
+	{
+		//The content has never been created, so its settings are still the ones it was restored from
+		item_group = item->deferred_settings()->clone();
+	}
+	else if (ISQTYPE(item->content(), i_settings_provider))
+		item_group = ((i_settings_provider*)item->content())->save_settings();
+	else
+	{
+		qDebug() << "styled_dock_widget: Item not derived from i_settings_provider, no settings saved";
+		return nullptr;
+	}
+
+	item_group->key("item[" + QString::number(idx) + "]");
+	item_group->values()["idx"] = QString::number(idx);
+	item_group->values()["item_title"] = item->title();
+	return item_group;
+}
+void styled_dock_widget::load_item(settings_group* item_group)
+{
+	if (m_factory->defer_content())
+		add_item(new styled_dock_item(item_group->values()["item_title"], m_factory, item_group->clone()));
+	else
+		m_factory->load(this, item_group);
+}
+const char* styled_dock_widget::orientation_name() const
+{
+	if (m_orientation == styled_dock_orientation::top)
+		return "top";
+	else
+		return "bottom";
+}
 styled_window* styled_dock_widget::drag_window(QList<styled_dock_item*> items, styled_dock_widget** dock_widget)
+{
+	//Creating a window takes too long for a mouse move handler, so a pre-warmed one is used when possible
+	styled_window* window = take_drag_window(m_orientation, m_factory, dock_widget);
+	if (window == nullptr)
+		window = create_drag_window(m_orientation, m_factory, dock_widget);
+
+	window->flags(window->flags() | styled_window::window_flags::hittest_visible);
+	QObject::connect(window, SIGNAL(frameless_changed(bool)), *dock_widget, SLOT(dragwindow_frameless_changed(bool)), Qt::UniqueConnection);
+
+	for (auto item : items)
+		(*dock_widget)->add_item(item);
+
+	return window;
+}
+styled_window* styled_dock_widget::create_drag_window(styled_dock_orientation orientation, base_widget_factory* factory, styled_dock_widget** dock_widget)
 {
 	styled_window* window = new styled_window("tpengine::editor");
 	window->flags(window->flags() | styled_window::window_flags::delete_on_close);
@@ -608,36 +971,134 @@ styled_window* styled_dock_widget::drag_window(QList<styled_dock_item*> items, s
 	layout->setContentsMargins(0, 0, 0, 0);
 	window->client_widget()->setLayout(layout);
 
-	styled_dock_splitter* splitter = new styled_dock_splitter(Qt::Horizontal, m_factory, true);
+	styled_dock_splitter* splitter = styled_dock_splitter::create_recycled(Qt::Horizontal, factory, true);
 	layout->addWidget(splitter, 0, 0);
 
-	*dock_widget = new styled_dock_widget(this->m_orientation, m_factory, "", true);
+	*dock_widget = create_recycled(orientation, factory, "", true);
 	splitter->addWidget(*dock_widget);
 	
 
 	(*dock_widget)->setObjectName("part_dragwindow_dockwidget");
 
-	for (auto item : items)
-		(*dock_widget)->add_item(item);
-
-	QObject::connect(window, SIGNAL(frameless_changed(bool)), *dock_widget, SLOT(dragwindow_frameless_changed(bool)));
 	QObject::connect(window, SIGNAL(moved()), *dock_widget, SLOT(dragwindow_moved()));
 	QObject::connect(window, SIGNAL(move_started()), *dock_widget, SLOT(dragwindow_move_started()));
 	QObject::connect(window, SIGNAL(move_ended()), *dock_widget, SLOT(dragwindow_move_ended()));
 
 	return window;
 }
+styled_dock_widget* styled_dock_widget::drag_window_dock_widget(styled_window* window)
+{
+	return window->client_widget()->findChild<styled_dock_widget*>("part_dragwindow_dockwidget");
+}
+styled_window* styled_dock_widget::take_drag_window(styled_dock_orientation orientation, base_widget_factory* factory, styled_dock_widget** dock_widget)
+{
+	for (int i = 0; i < m_drag_window_pool.count(); i++)
+	{
+		auto pooled_widget = m_drag_window_pool[i].dock_widget;
+		if (pooled_widget->m_orientation == orientation && pooled_widget->m_factory == factory)
+		{
+			*dock_widget = pooled_widget;
+			return m_drag_window_pool.takeAt(i).window;
+		}
+	}
+
+	return nullptr;
+}
+void styled_dock_widget::prewarm(styled_dock_orientation orientation, base_widget_factory* factory)
+{
+	auto key = qMakePair(orientation, factory);
+	if (m_pending_prewarms.contains(key))
+		return;
+
+	for (auto& pooled : m_drag_window_pool)
+	{
+		if (pooled.dock_widget->m_orientation == orientation && pooled.dock_widget->m_factory == factory)
+			return;
+	}
+
+	m_pending_prewarms.push_back(key);
+	QTimer::singleShot(0, qApp, [key]()
+	{
+		m_pending_prewarms.removeOne(key);
+		warm_drag_window_pool(key.first, key.second);
+	});
+}
+void styled_dock_widget::warm_drag_window_pool(styled_dock_orientation orientation, base_widget_factory* factory)
+{
+	if (m_drag_window_pool.count() >= DRAG_WINDOW_POOL_SIZE)
+		return;
+
+	for (auto& pooled : m_drag_window_pool)
+	{
+		if (pooled.dock_widget->m_orientation == orientation && pooled.dock_widget->m_factory == factory)
+			return;
+	}
+
+	pooled_drag_window pooled;
+	pooled.window = create_drag_window(orientation, factory, &pooled.dock_widget);
+
+	//Pooled windows are never drop targets
+	pooled.window->flags(pooled.window->flags() & ~styled_window::window_flags::hittest_visible);
+	m_drag_window_pool.push_back(pooled);
+}
+bool styled_dock_widget::recycle_drag_window(styled_window* window)
+{
+	if (m_drag_window_pool.count() >= DRAG_WINDOW_POOL_SIZE)
+		return false;
+
+	//Only windows that still have their initial layout (a single dock widget) can be reused
+	int count = 0;
+	for (auto dwidget : m_all_dock_widgets)
+		if (dwidget->window() == window)
+			count++;
+
+	auto dock_widget = drag_window_dock_widget(window);
+	if (count != 1 || dock_widget == nullptr || dock_widget->window() != window)
+		return false;
+
+	dock_widget->detach_items();
+	window->hide();
+	window->flags(window->flags() & ~styled_window::window_flags::hittest_visible);
+
+	pooled_drag_window pooled;
+	pooled.window = window;
+	pooled.dock_widget = dock_widget;
+	m_drag_window_pool.push_back(pooled);
+	return true;
+}
+void styled_dock_widget::detach_items()
+{
+	//The items already belong to a different dock widget, only the references to them are dropped
+	for (auto item : m_items)
+	{
+		QObject::disconnect(item, nullptr, this, nullptr);
+		if (m_tabbar_widgets.contains(item))
+			release_tab(item);
+	}
+
+	m_items.clear();
+	m_item_indices.clear();
+	m_tab_sizes.clear();
+	m_selected_item = nullptr;
+
+	m_part_tabbar_layout->tabs_changed();
+	update_tabbar();
+}
 void styled_dock_widget::set_focus(bool focused)
 {
-	this->findChild<styled_frame*>("part_sdw_contentframe")->custom_data_1(focused);
+	if (m_has_focus == focused)
+		return;
+
+	m_part_contentframe->custom_data_1(focused);
 	m_part_titleframe->custom_data_1(focused);
-	m_part_titleframe->findChild<styled_pushbutton*>("part_sdw_title_closebutton")->custom_data_1(focused);
+	m_part_title_closebutton->custom_data_1(focused);
 	m_part_overflow_button->custom_data_1(focused);
+	m_has_focus = focused;
 
 	for (auto w : m_tabbar_widgets)
 	{
 		w->custom_data_1(focused);
-		w->findChild<styled_pushbutton*>("part_sdw_tab_closebutton")->custom_data_1(focused);
+		m_tab_closebuttons[w]->custom_data_1(focused);
 	}
 }
 
@@ -646,8 +1107,9 @@ void styled_dock_widget::tabbar_widget_mousePressed(QMouseEvent* event)
 	styled_frame* s = (styled_frame*)sender();
 	auto* item = m_widget_to_item[s];
 	select(item);
-	item->content()->setFocus(Qt::FocusReason::MouseFocusReason);
+	focus_item(item);
 	m_drag_item = item;
+	prewarm(m_orientation, m_factory);
 	m_drag_reference_x = (s->mapToGlobal(QPoint(0, 0)).x() + s->mapToGlobal(QPoint(s->width(), s->height())).x()) / 2;
 }
 void styled_dock_widget::tabbar_widget_mouseReleased(QMouseEvent* event)
@@ -675,8 +1137,8 @@ void styled_dock_widget::tabbar_widget_mouseMove(QMouseEvent* event)
 			window->flags(window->flags() | styled_window::window_flags::frameless | styled_window::window_flags::frame_on_stop_move);
 			(dock_widget)->m_part_overflow_button->setVisible(false);
 			(dock_widget)->m_part_tabbar->selected(true);
-			(dock_widget)->findChild<styled_frame*>("part_sdw_background")->selected(true);
-			(dock_widget)->findChild<styled_frame*>("part_sdw_contentframe")->selected(true);
+			(dock_widget)->m_part_background->selected(true);
+			(dock_widget)->m_part_contentframe->selected(true);
 			releaseMouse();
 			window->show();
 
@@ -718,8 +1180,7 @@ void styled_dock_widget::tabbar_widget_mouseMove(QMouseEvent* event)
 void styled_dock_widget::tabbar_widget_hover_changed(bool value)
 {
 	styled_frame* s = (styled_frame*)sender();
-	auto close_button = s->findChild<styled_pushbutton*>("part_sdw_tab_closebutton");
-	close_button->parent_hover(value);
+	m_tab_closebuttons[s]->parent_hover(value);
 }
 void styled_dock_widget::tabbar_close_button_clicked(bool is_checked)
 {
@@ -732,24 +1193,21 @@ void styled_dock_widget::tabbar_overflowChanged(bool is_overflow)
 	m_part_overflow_button->selected(is_overflow);
 
 	if (!m_ignore_overflow_changed)
-	{
-		if (m_selected_item != nullptr && !m_part_tabbar_layout->isVisible(m_tabbar_widgets[m_selected_item]) && m_items[0] != m_selected_item)
-		{
-			auto item = m_selected_item;
-			m_items.removeAt(m_items.indexOf(item));
-			m_items.insert(0, item);
-			select(0);
-			items_changed();
-		}
-	}
+		show_selected_tab();
 }
-void styled_dock_widget::tabbar_overflow_action_triggered(bool is_checked)
+void styled_dock_widget::tabbar_overflow_action_triggered(QAction* action)
 {
-	auto action = (QAction*)sender();
 	auto item = (styled_dock_item*)qvariant_cast<void*>(action->data());
 
 	select(item);
-	item->content()->setFocus(Qt::FocusReason::MouseFocusReason);
+	focus_item(item);
+}
+void styled_dock_widget::overflow_menu_aboutToShow()
+{
+	//The entries are created from the item list when the menu is opened and are removed again when it is closed
+	m_overflow_menu->clear();
+	for (auto item : m_items)
+		m_overflow_menu->addAction(item->title())->setData(qVariantFromValue((void*)item));
 }
 void styled_dock_widget::dragwindow_frameless_changed(bool is_frameless)
 {
@@ -760,8 +1218,8 @@ void styled_dock_widget::dragwindow_frameless_changed(bool is_frameless)
 
 		dock_widget->m_part_overflow_button->setVisible(true);
 		dock_widget->m_part_tabbar->selected(false);
-		dock_widget->findChild<styled_frame*>("part_sdw_background")->selected(false);
-		dock_widget->findChild<styled_frame*>("part_sdw_contentframe")->selected(false);
+		dock_widget->m_part_background->selected(false);
+		dock_widget->m_part_contentframe->selected(false);
 
 		QObject::disconnect(sender(), SIGNAL(frameless_changed(bool)), this, SLOT(dragwindow_frameless_changed(bool)));
 	}
@@ -772,16 +1230,18 @@ void styled_dock_widget::dragwindow_moved()
 
 	auto cp = QCursor::pos();
 
-	auto top_drag_widget = front_widget_at(cp);
+	styled_dock_widget* top_drag_widget = nullptr;
+	if (!flag_contains(w->flags(), styled_window::window_flags::hittest_visible))
+		top_drag_widget = m_drop_targets.widget_at(cp);
+
+	//Only the widget that showed the overlay until now has to hide it
+	if (m_overlay_target != nullptr && m_overlay_target != top_drag_widget)
+		m_overlay_target->show_overlay(false, cp);
 
-	for (auto w : m_all_dock_widgets)
-		if (w != top_drag_widget)
-			w->show_overlay(false, cp);
+	m_overlay_target = top_drag_widget;
 
-	if (top_drag_widget != nullptr && !flag_contains(w->flags(), styled_window::window_flags::hittest_visible))
-	{
+	if (top_drag_widget != nullptr)
 		top_drag_widget->show_overlay(true, cp);
-	}
 }
 void styled_dock_widget::dragwindow_move_started()
 {
@@ -793,7 +1253,12 @@ void styled_dock_widget::dragwindow_move_started()
 			c++;
 
 	if (c <= 1)
+	{
 		w->flags(w->flags() & ~styled_window::window_flags::hittest_visible);
+
+		//The drop targets don't move during the drag, so they are collected only once. The dragged window is excluded, since it is no longer hittest visible
+		m_drop_targets.build(front_to_back_widgets());
+	}
 }
 void styled_dock_widget::dragwindow_move_ended()
 {
@@ -801,7 +1266,7 @@ void styled_dock_widget::dragwindow_move_ended()
 
 	if (!flag_contains(w->flags(), styled_window::window_flags::hittest_visible))
 	{
-		auto top_drag_widget = front_widget_at(QCursor::pos());
+		auto top_drag_widget = m_drop_targets.widget_at(QCursor::pos());
 		if (top_drag_widget != nullptr)
 		{
 			for (auto dwidget : m_all_dock_widgets)
@@ -810,11 +1275,13 @@ void styled_dock_widget::dragwindow_move_ended()
 				{
 					dwidget->select(nullptr);
 					top_drag_widget->drop_item(dwidget->m_items, dwidget->m_orientation);
-					dwidget->m_items.clear();
+					dwidget->detach_items();
 				}
 			}
 
-			w->close();
+			//The empty window is kept hidden for the next tear-off
+			if (!recycle_drag_window(w))
+				w->close();
 		}
 		else
 		{
@@ -822,8 +1289,14 @@ void styled_dock_widget::dragwindow_move_ended()
 		}
 	}
 
-	for (auto dw : m_all_dock_widgets)
-		dw->show_overlay(false, QCursor::pos());
+	if (m_overlay_target != nullptr)
+		m_overlay_target->show_overlay(false, QCursor::pos());
+
+	m_overlay_target = nullptr;
+	m_drop_targets.clear();
+
+	//Replaces the pooled window that was used for this drag, now that creating a window doesn't delay the user anymore
+	warm_drag_window_pool(m_orientation, m_factory);
 }
 void styled_dock_widget::title_close_button_clicked(bool is_checked)
 {
@@ -831,7 +1304,8 @@ void styled_dock_widget::title_close_button_clicked(bool is_checked)
 }
 void styled_dock_widget::title_mousePressed(QMouseEvent* event)
 {
-	this->m_selected_item->content()->setFocus(Qt::FocusReason::MouseFocusReason);
+	if (m_selected_item != nullptr)
+		focus_item(m_selected_item);
 	m_title_mousedown = true;
 }
 void styled_dock_widget::title_mouseReleased(QMouseEvent* event)
@@ -866,20 +1340,27 @@ void styled_dock_widget::title_mouseMove(QMouseEvent* event)
 }
 void styled_dock_widget::application_focus_changed(QWidget* old_widget, QWidget* new_widget)
 {
-	bool me_focus = false;
+	//All dock widgets that contain the focus widget (there might be more than one when dock widgets are nested)
+	QList<styled_dock_widget*> focused_widgets;
 
 	QObject* o = new_widget;
 	while (o != nullptr)
 	{
-		if (o == this)
-		{
-			me_focus = true;
-			break;
-		}
+		auto dock_widget = qobject_cast<styled_dock_widget*>(o);
+		if (dock_widget != nullptr)
+			focused_widgets.push_back(dock_widget);
 		o = o->parent();
 	}
 
-	this->set_focus(me_focus);
+	for (auto w : m_focused_widgets)
+	{
+		if (!focused_widgets.contains(w))
+			w->set_focus(false);
+	}
+	for (auto w : focused_widgets)
+		w->set_focus(true);
+
+	m_focused_widgets = focused_widgets;
 
 	/*if (new_widget != nullptr)
 		qDebug() << "Focus: " << new_widget->metaObject()->className() << ", " << new_widget->objectName();
@@ -887,9 +1368,32 @@ void styled_dock_widget::application_focus_changed(QWidget* old_widget, QWidget*
 		qDebug() << "Focus: none";*/
 }
 
-void styled_dock_widget::item_title_changed(bdl::styled_qt_controls::styled_dock_item*)
+void styled_dock_widget::item_content_created(bdl::styled_qt_controls::styled_dock_item* item)
+{
+	add_content(item);
+
+	if (item == m_selected_item)
+	{
+		//The placeholder was focused while the content was loading, the focus moves on to the content
+		bool placeholder_focused = m_part_placeholder->hasFocus();
+
+		this->setFocusProxy(item->content());
+		update_placeholder();
+
+		if (placeholder_focused)
+			item->content()->setFocus(Qt::FocusReason::OtherFocusReason);
+	}
+}
+void styled_dock_widget::item_title_changed(bdl::styled_qt_controls::styled_dock_item* item)
 {
-	items_changed();
+	m_tab_sizes.remove(item);
+	if (m_tabbar_widgets.contains(item))
+		m_tab_labels[m_tabbar_widgets[item]]->setText(item->title());
+	m_part_tabbar_layout->tabs_changed();
+	show_selected_tab();
+
+	if (item == m_selected_item)
+		m_part_titlebar_label->setText(item->title());
 }
 
 
@@ -934,27 +1438,14 @@ QVector<styled_dock_widget*> styled_dock_widget::front_to_back_widgets()
 
 	return result;
 }
-styled_dock_widget* styled_dock_widget::front_widget_at(const QPoint& p)
-{
-	auto ftb_widgets = front_to_back_widgets();
-
-	for (auto dwidget : ftb_widgets)
-	{
-		auto r = dwidget->rect();
-		auto mp = dwidget->mapFromGlobal(p);
-
-		if (dwidget->rect().contains(dwidget->mapFromGlobal(p)))
-			return dwidget;
-	}
-
-	return nullptr;
-}
 
 settings_group* styled_dock_widget::save_settings()
 {
+	trace_scope scope("styled_dock_widget::save_settings");
+
 	settings_group* sgroup = new settings_group("styled_dock_widget");
 	sgroup->values()["type"] = "styled_dock_widget";
-	sgroup->values()["selected_idx"] = QString::number(m_items.indexOf(m_selected_item));
+	sgroup->values()["selected_idx"] = QString::number(index_of(m_selected_item));
 	sgroup->values()["tag"] = m_tag;
 
 	if (m_remove_on_empty)
@@ -971,15 +1462,9 @@ settings_group* styled_dock_widget::save_settings()
 
 	for (auto item : m_items)
 	{
-		if (ISQTYPE(item->content(), i_settings_provider))
-		{
-			auto item_group = ((i_settings_provider*)item->content())->save_settings();
-			item_group->key("item[" + QString::number(idx) + "]");
-			item_group->values()["idx"] = QString::number(idx);
+		auto item_group = save_item(item, idx);
+		if (item_group != nullptr)
 			sgroup->add_group(item_group);
-		}
-		else
-			qDebug() << "styled_dock_widget: Item not derived from i_settings_provider, no settings saved";
 
 		idx++;
 	}
@@ -988,9 +1473,14 @@ settings_group* styled_dock_widget::save_settings()
 }
 void styled_dock_widget::load_settings(settings_group* group)
 {
+	trace_scope scope("styled_dock_widget::load_settings");
+
 	this->m_tag = group->values()["tag"];
 	this->m_remove_on_empty = group->values()["remove_on_empty"] == "True";
 
+	m_loading = true;
+	m_part_tabbar_layout->begin_update();
+
 	int done = 0;
 	int idx = 0;
 	while (done < group->groups().count())
@@ -999,16 +1489,21 @@ void styled_dock_widget::load_settings(settings_group* group)
 
 		if (group->groups().contains(key))
 		{
-			m_factory->load(this, group->groups()[key]);
+			load_item(group->groups()[key]);
 			done++;
 		}
 
 		idx++;
 	}
 
+	m_part_tabbar_layout->end_update();
+	m_loading = false;
+
 	int selected_idx = group->values()["selected_idx"].toInt();
 	if (m_items.count() > selected_idx)
 		this->select(selected_idx);
+	else if (m_selected_item != nullptr)
+		this->select(m_selected_item);
 
 
 
@@ -1047,13 +1542,67 @@ void styled_dock_widget::load_settings(settings_group* group)
 	if (select_idx != -1)
 		this->select(select_idx);*/
 }
+void styled_dock_widget::write_layout(QDataStream& stream)
+{
+	//Items without settings are skipped, so the groups are collected before the count is written
+	QList<settings_group*> item_groups;
+	int idx = 0;
+	for (auto item : m_items)
+	{
+		auto item_group = save_item(item, idx++);
+		if (item_group != nullptr)
+			item_groups.push_back(item_group);
+	}
+
+	stream << (quint8)m_remove_on_empty << (qint32)index_of(m_selected_item) << m_tag;
+	stream << (quint32)item_groups.count();
+
+	for (auto item_group : item_groups)
+	{
+		settings_io::write_group(stream, item_group);
+		delete item_group;
+	}
+}
+bool styled_dock_widget::read_layout(QDataStream& stream)
+{
+	quint8 remove_on_empty;
+	qint32 selected_idx;
+	quint32 item_count;
+	stream >> remove_on_empty >> selected_idx >> m_tag >> item_count;
+	if (stream.status() != QDataStream::Ok)
+		return false;
+
+	m_remove_on_empty = remove_on_empty != 0;
+
+	m_loading = true;
+	m_part_tabbar_layout->begin_update();
+
+	for (quint32 i = 0; i < item_count; i++)
+	{
+		std::unique_ptr<settings_group> item_group(settings_io::read_group(stream));
+		if (item_group == nullptr)
+			break;
+
+		load_item(item_group.get());
+	}
+
+	m_part_tabbar_layout->end_update();
+	m_loading = false;
+
+	if (selected_idx >= 0 && m_items.count() > selected_idx)
+		this->select(selected_idx);
+	else if (m_selected_item != nullptr)
+		this->select(m_selected_item);
+
+	return stream.status() == QDataStream::Ok;
+}
 
 QSize styled_dock_widget::minimumSizeHint() const
 {
 	QSize originalHint = styled_widget::minimumSizeHint();
 
 	QSize currentTabSize(0,0);
-	if (m_selected_item != nullptr)
+	if (m_selected_item != nullptr && m_selected_item->content() != nullptr)
 		currentTabSize = m_selected_item->content()->minimumSizeHint();
 
 	int max_tab_height = 0;
@@ -1061,6 +1610,10 @@ QSize styled_dock_widget::minimumSizeHint() const
 
 	for (auto c : this->m_items)
 	{
+		//Deferred items don't contribute, their content doesn't exist yet
+		if (c->content() == nullptr)
+			continue;
+
 		auto csize = c->content()->minimumSizeHint();
 		max_tab_height = max(max_tab_height, csize.height());
 		max_tab_width = max(max_tab_width, csize.width());
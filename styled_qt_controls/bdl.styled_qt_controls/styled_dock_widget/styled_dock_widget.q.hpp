@@ -24,6 +24,8 @@
 #include "styled_dock_item.q.hpp"
 #include "styled_dock_overlay.q.hpp"
 #include "styled_dock_splitter.q.hpp"
+#include "i_dock_tab_provider.hpp"
+#include "dock_target_index.hpp"
 #include "../styled_controls/styled_widget.q.hpp"
 #include "../styled_controls/styled_pushbutton.q.hpp"
 #include "../styled_controls/styled_frame.q.hpp"
@@ -39,8 +41,10 @@ enum class styled_dock_orientation { top, bottom };
 /*! \brief A customized dock widget
 	*
 	* \author bdl
+	*
+	* Tab widgets are only created for the tabs that fit into the tabbar and are reused when other tabs become visible.
 	*/
-class BDL_SQTC_EXPORT styled_dock_widget : public styled_widget
+class BDL_SQTC_EXPORT styled_dock_widget : public styled_widget, public i_dock_tab_provider
 {
 	Q_OBJECT;
 
@@ -53,15 +57,30 @@ class BDL_SQTC_EXPORT styled_dock_widget : public styled_widget
 	PROPERTY0(styled_frame*, part_titleframe);
 	PROPERTY0(QGridLayout*, content_layout);
 	PROPERTY0(styled_label*, part_titlebar_label);
+	PROPERTY0(styled_label*, part_placeholder);
+	PROPERTY0(styled_frame*, part_background);
+	PROPERTY0(styled_frame*, part_contentframe);
+	PROPERTY0(styled_pushbutton*, part_title_closebutton);
 
 	//! Stores the orientation of the tabbar
 	PROPERTY1(styled_dock_orientation, orientation, GET);
 
 	typedef QHash<styled_dock_item*, styled_frame*> item_frame_hashtable;
 	typedef QHash<styled_frame*, styled_dock_item*> frame_item_hashtable;
+	typedef QHash<styled_dock_item*, QSize> item_size_hashtable;
+	typedef QHash<styled_dock_item*, int> item_index_hashtable;
+	typedef QHash<styled_frame*, styled_label*> frame_label_hashtable;
+	typedef QHash<styled_frame*, styled_pushbutton*> frame_button_hashtable;
 	PROPERTY0(QList<styled_dock_item*>, items);
+	//! Index of each item in m_items. Cleared when the order changes and rebuilt by index_of
+	PROPERTY0(item_index_hashtable, item_indices);
 	PROPERTY0(item_frame_hashtable, tabbar_widgets);
 	PROPERTY0(frame_item_hashtable, widget_to_item);
+	PROPERTY0(QList<styled_frame*>, tab_pool);
+	PROPERTY0(styled_frame*, measure_tab);
+	PROPERTY0(item_size_hashtable, tab_sizes);
+	PROPERTY0(frame_label_hashtable, tab_labels);
+	PROPERTY0(frame_button_hashtable, tab_closebuttons);
 
 	PROPERTY0(styled_dock_item*, selected_item);
 
@@ -77,6 +96,8 @@ class BDL_SQTC_EXPORT styled_dock_widget : public styled_widget
 	PROPERTY0(bool, has_focus);
 
 	PROPERTY0(bool, ignore_overflow_changed);
+	PROPERTY0(bool, loading);
+	PROPERTY0(bool, shown);
 	PROPERTY0(base_widget_factory*, factory);
 
 public:
@@ -92,6 +113,43 @@ public:
 		*/
 	~styled_dock_widget();
 
+	/*! \brief Returns an empty dock widget that removed itself from its parent before, or a new dock widget when none is available
+		*
+		* Recycled dock widgets keep their polished parts and tabs, so no stylesheet has to be parsed for them.
+		*
+		* \param orientation Orientation of the tabs in the widget
+		* \param factory Factory used to restore items in the widget (used by load_settings)
+		* \param tag Tag that can be used to store user data
+		* \param remove_on_empty Sets whether or not the widget should be removed from its parent when there are no items left
+		* \returns The dock widget
+		*/
+	static styled_dock_widget* create_recycled(styled_dock_orientation orientation, base_widget_factory* factory, const QString& tag = "", bool remove_on_empty = false);
+	/*! \brief Prepares a hidden window for tearing off tabs once the application is idle
+		*
+		* This happens on the first tab press of a dock widget anyway. Calling it after a layout has been created saves the first
+		* tear-off the creation of the window. Only one window is prepared per orientation and factory.
+		*
+		* \param orientation Orientation of the tabs in the dock widgets that will be torn off
+		* \param factory Factory of the dock widgets that will be torn off
+		*/
+	static void prewarm(styled_dock_orientation orientation, base_widget_factory* factory);
+
+	/*! \brief Starts a dock transaction. Transactions can be nested
+		*
+		* Until the outermost transaction is committed, the tab bars of the changed dock widgets are not placed again,
+		* splitter sizes set with styled_dock_splitter::set_sizes are not applied and the affected windows are not repainted.
+		* A drop of several items or a programmatic layout change thereby causes a single relayout.
+		*/
+	static void begin_transaction();
+	/*! \brief Ends a transaction started with begin_transaction. The deferred changes are applied when it is the outermost one
+		*/
+	static void commit_transaction();
+	/*! \brief Returns whether a dock transaction is open
+		*
+		* \returns True between begin_transaction and the matching commit_transaction
+		*/
+	static bool in_transaction();
+
 	/*! \brief Adds an item to the dock_widget
 		*
 		* \param item The item to add
@@ -135,6 +193,17 @@ public:
 		* \param group The settings_group from which the settings should be loaded
 		*/
 	void load_settings(util::settings_group* group);
+	/*! \brief Writes the widget and its items to a binary layout stream (see styled_dock_splitter::save_layout)
+		*
+		* \param stream The stream to write to
+		*/
+	void write_layout(QDataStream& stream);
+	/*! \brief Restores the widget and its items from a binary layout stream written by write_layout
+		*
+		* \param stream The stream to read from
+		* \returns False when the stream is truncated or corrupt
+		*/
+	bool read_layout(QDataStream& stream);
 
 	/*! \brief Returns a list of all styled_dock_widgets currently present in the application
 		*
@@ -150,6 +219,21 @@ protected:
 	virtual void paintEvent(QPaintEvent *pe);
 	//! See QWidget
 	virtual void resizeEvent(QResizeEvent * event);
+	//! See QWidget
+	virtual void showEvent(QShowEvent* event);
+	//! See QWidget
+	virtual void hideEvent(QHideEvent* event);
+	//! See QObject
+	virtual bool eventFilter(QObject* obj, QEvent* ev);
+
+	//! See i_dock_tab_provider
+	virtual int tab_count();
+	//! See i_dock_tab_provider
+	virtual QSize tab_size_hint(int idx);
+	//! See i_dock_tab_provider
+	virtual QWidget* bind_tab(int idx);
+	//! See i_dock_tab_provider
+	virtual void release_tabs(int visible_count);
 
 private slots:
 	void tabbar_widget_mousePressed(QMouseEvent* event);
@@ -158,29 +242,45 @@ private slots:
 	void tabbar_widget_hover_changed(bool value);
 	void tabbar_close_button_clicked(bool is_checked);
 	void tabbar_overflowChanged(bool is_overflow);
-	void tabbar_overflow_action_triggered(bool is_checked);
+	void tabbar_overflow_action_triggered(QAction* action);
+	void overflow_menu_aboutToShow();
 	void title_close_button_clicked(bool is_checked);
 	void title_mousePressed(QMouseEvent* event);
 	void title_mouseReleased(QMouseEvent* event);
 	void title_mouseMove(QMouseEvent* event);
 
-	void application_focus_changed(QWidget* old_widget, QWidget* new_widget);
-
 	void dragwindow_frameless_changed(bool is_frameless);
 	void dragwindow_moved();
 	void dragwindow_move_started();
 	void dragwindow_move_ended();
 
 	void item_title_changed(bdl::styled_qt_controls::styled_dock_item*);
+	void item_content_created(bdl::styled_qt_controls::styled_dock_item* item);
 
 private:
-	void items_changed();
-	styled_frame* tabbar_widget(styled_dock_item* item);
+	void insert_tab(styled_dock_item* item);
+	void remove_tab(styled_dock_item* item);
+	void move_tab(styled_dock_item* item, int idx);
+	void show_selected_tab();
+	void add_content(styled_dock_item* item);
+	void update_placeholder();
+	void focus_item(styled_dock_item* item);
+	void update_suspension(styled_dock_item* item);
+	void update_tabbar();
+	styled_frame* tabbar_widget();
+	void tab_selected(styled_frame* tab, bool selected);
+	void release_tab(styled_dock_item* item);
+	int index_of(styled_dock_item* item);
+	util::settings_group* save_item(styled_dock_item* item, int idx);
+	void load_item(util::settings_group* item_group);
+	const char* orientation_name() const;
 	styled_window* drag_window(QList<styled_dock_item*> items, styled_dock_widget** dock_widget);
+	void detach_items();
 	void swap(styled_dock_item* first, styled_dock_item* second);
 	void show_overlay(bool show, const QPoint& pos);
 	void drop_item(const QList<styled_dock_item*>& items, styled_dock_orientation preferred_orientation);
 	void set_focus(bool focused);
+	void join_transaction();
 
 	void remove_item_internal(int idx, bool signal_closed);
 	void remove_item_internal(styled_dock_item* item, bool signal_closed);
@@ -188,9 +288,34 @@ private:
 	styled_window* window();
 	styled_dock_splitter* splitter(int& idx);
 	static QVector<styled_dock_widget*> front_to_back_widgets();
-	static styled_dock_widget* front_widget_at(const QPoint& p);
+
+	static void application_focus_changed(QWidget* old_widget, QWidget* new_widget);
+
+	static styled_window* create_drag_window(styled_dock_orientation orientation, base_widget_factory* factory, styled_dock_widget** dock_widget);
+	static styled_window* take_drag_window(styled_dock_orientation orientation, base_widget_factory* factory, styled_dock_widget** dock_widget);
+	static styled_dock_widget* drag_window_dock_widget(styled_window* window);
+	static void warm_drag_window_pool(styled_dock_orientation orientation, base_widget_factory* factory);
+	static bool recycle_drag_window(styled_window* window);
 
 	static QList<styled_dock_widget*> m_all_dock_widgets;
+	static QList<styled_dock_widget*> m_focused_widgets;
+	static bool m_focus_tracker_connected;
+	static dock_target_index m_drop_targets;
+	static styled_dock_widget* m_overlay_target;
+	//Hidden drag windows that are reused for tearing off tabs
+	struct pooled_drag_window
+	{
+		styled_window* window;
+		styled_dock_widget* dock_widget;
+	};
+	static QList<pooled_drag_window> m_drag_window_pool;
+	static QList<QPair<styled_dock_orientation, base_widget_factory*>> m_pending_prewarms;
+	//Empty dock widgets that removed themselves from their parent
+	static QList<styled_dock_widget*> m_recycled_widgets;
+	//State of the open dock transaction (see begin_transaction)
+	static int m_transaction_depth;
+	static QList<styled_dock_widget*> m_transaction_widgets;
+	static QList<QPointer<QWidget>> m_transaction_windows;
 };
 
 END_BDL_SQTC
\ No newline at end of file
@@ -30,7 +30,7 @@ styled_item_editor::styled_item_editor() : m_editing(true)
 
 	QWidget* content_widget = new QWidget();
 	content_widget->setObjectName("part_sie_content_widget");
-	content_widget->setStyleSheet(loader.style_string());
+	loader.apply_to(content_widget);
 	content_widget->setMinimumSize(100, 100);
 	content_widget->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Minimum);
 
@@ -78,7 +78,7 @@ styled_path_widget::styled_path_widget() : m_is_undo_redo(false)
 
 
 	style_loader loader(":/styled_path_widget/styled_path_widget.qss");
-	this->setStyleSheet(loader.style_string());
+	loader.apply_to(this);
 }
 styled_path_widget::~styled_path_widget()
 {
@@ -34,8 +34,14 @@
 #include <QtCore\QFileinfo>
 #include <QtCore\QDebug>
 #include <QtCore\QThread>
+#include <QtCore\QThreadPool>
 #include <QtCore\QMimeData>
 #include <QtCore\QTimer>
+#include <QtCore\QtEndian>
+#include <QtCore\QElapsedTimer>
+#include <QtCore\QTextStream>
+#include <QtCore\QDataStream>
+#include <QtCore\QPointer>
 
 #include <QtGui\QColor>
 #include <QtGui\5.7.0\QtGui\qpa\qplatformnativeinterface.h>
@@ -65,6 +71,7 @@
 #include <QtWidgets\QButtongroup>
 #include <QtWidgets\QCheckbox>
 #include <QtWidgets\QMessagebox>
+#include <QtWidgets\QProxyStyle>
 
 #include <QtXml\QDomDocument>
 
@@ -140,6 +147,7 @@
 #include "styled_dock_widget\styled_dock_overlay.q.hpp"
 #include "styled_dock_widget\styled_dock_layout.q.hpp"
 #include "styled_dock_widget\styled_dock_item.q.hpp"
+#include "styled_dock_widget\styled_dock_snapshot.hpp"
 
 #include "styled_item_editor\base_editor_group.q.hpp"
 #include "styled_item_editor\item_editor_group.q.hpp"
@@ -150,9 +158,13 @@
 #include "styled_path_widget\styled_path_widget_item.q.hpp"
 #include "styled_path_widget\styled_path_widget_layout.q.hpp"
 
+#include "util\async_task.q.hpp"
 #include "util\qt_helper_functions.hpp"
 #include "util\style_loader.hpp"
+#include "util\style_state.hpp"
 #include "util\theme_colors.hpp"
+#include "util\theme_style.hpp"
+#include "util\trace_profiler.hpp"
 #include "util\os\file_system_watcher.q.hpp"
 #include "util\os\icon_loader.hpp"
 #include "util\os\os_sound.hpp"
@@ -70,7 +70,7 @@ int styled_messagebox::show(styled_window* parent, const QString& title, const Q
 	styled_dialog* diag = new styled_dialog(title, parent, -1, styled_window::window_flags::hittest_visible);
 
 	util::style_loader loader(":/styled_window/styled_messagebox.qss");
-	diag->client_widget()->setStyleSheet(loader.style_string());
+	loader.apply_local(diag->client_widget());
 
 	QGridLayout* layout = new QGridLayout();
 	layout->setSpacing(20);
@@ -22,6 +22,7 @@
 
 #include "../util/os/icon_loader.hpp"
 #include "../util/style_loader.hpp"
+#include "../util/trace_profiler.hpp"
 #include <WinUser.h>
 
 using namespace bdl::styled_qt_controls;
@@ -30,9 +31,33 @@ using namespace bdl::styled_qt_controls::util;
 QHash<HWND, styled_window*> styled_window::m_all_windows;
 QHash<QWidget*, styled_window*> styled_window::m_widget_to_window;
 
+namespace
+{
+	//Application event filters run before the layout of the receiver handles a LayoutRequest, styled_window::eventFilter runs after it
+	class layout_request_filter : public QObject
+	{
+	public:
+		layout_request_filter(QObject* parent) : QObject(parent) {}
+
+		QHash<const QObject*, qint64> begin;
+
+		bool eventFilter(QObject* obj, QEvent* ev) override
+		{
+			if (ev->type() == QEvent::LayoutRequest && trace_profiler::enabled() && obj->isWidgetType() && styled_window::widget_to_window(static_cast<QWidget*>(obj)) != nullptr)
+				begin.insert(obj, trace_profiler::now());
+
+			return false;
+		}
+	};
+
+	layout_request_filter* layout_requests = nullptr;
+}
+
 styled_window::styled_window(QString title, styled_window* parent, window_type type, window_flags initial_flags) : m_hInstance(GetModuleHandle(NULL)), m_hwnd(0),
 	m_flags(initial_flags), m_type(type), m_title(title), m_parent(parent), m_part_window_widget(nullptr), m_internal_flags(internal_flags::none)
 {
+	trace_scope scope("styled_window::styled_window");
+
 	WNDCLASSEX wc = { 0 };
 	wc.cbSize = sizeof(WNDCLASSEX);
 	wc.style = CS_HREDRAW | CS_VREDRAW;
@@ -97,11 +122,18 @@ styled_window::styled_window(QString title, styled_window* parent, window_type t
 
 	m_all_windows.insert(m_hwnd, this);
 	m_widget_to_window.insert(m_part_window_widget, this);
+
+	if (layout_requests == nullptr)
+	{
+		layout_requests = new layout_request_filter(qApp);
+		qApp->installEventFilter(layout_requests);
+	}
 }
 styled_window::~styled_window()
 {
 	m_widget_to_window.remove(m_part_window_widget);
 	m_all_windows.remove(m_hwnd);
+	layout_requests->begin.remove(m_part_window_widget);
 	SetWindowLongPtr(this->m_hwnd, GWLP_USERDATA, 0);
 }
 
@@ -239,6 +271,8 @@ LRESULT CALLBACK styled_window::wnd_prc(HWND hWnd, UINT message, WPARAM wParam,
 
 void styled_window::initialize_widget()
 {
+	trace_scope scope("styled_window::initialize_widget");
+
 	m_part_window_widget = new styled_frame();
 	m_part_window_widget->setFocusPolicy(Qt::FocusPolicy::ClickFocus);
 	m_part_window_widget->installEventFilter(this);
@@ -249,7 +283,7 @@ void styled_window::initialize_widget()
 	loader.append_file(":/styled_window/default_view_style.qss");
 	loader.append_file(":/styled_controls/styled_collapse_widget.qss");
 	loader.append_file(":/styled_controls/clearable_line_edit.qss");
-	m_part_window_widget->setStyleSheet(loader.style_string());
+	loader.apply_to(m_part_window_widget);
 
 	SetWindowLong((HWND)m_part_window_widget->winId(), GWL_STYLE, WS_CHILD | WS_CLIPCHILDREN | WS_CLIPSIBLINGS);
 	QWindow* thisWindow = m_part_window_widget->windowHandle();
@@ -271,30 +305,30 @@ void styled_window::initialize_widget()
 	styled_widget* part_nw_widget = new styled_widget();
 	part_nw_widget->setFixedWidth(4);
 	part_nw_widget->setFixedHeight(4);
-	part_nw_widget->setStyleSheet("background: solid transparent");
+	part_nw_widget->setObjectName("part_border_widget");
 	styled_widget* part_w_widget = new styled_widget();
 	part_w_widget->setFixedWidth(4);
-	part_w_widget->setStyleSheet("background: solid transparent");
+	part_w_widget->setObjectName("part_border_widget");
 	styled_widget* part_sw_widget = new styled_widget();
 	part_sw_widget->setFixedWidth(4);
 	part_sw_widget->setFixedHeight(4);
-	part_sw_widget->setStyleSheet("background: solid transparent");
+	part_sw_widget->setObjectName("part_border_widget");
 	
 	styled_widget* part_s_widget = new styled_widget();
 	part_s_widget->setFixedHeight(4);
-	part_s_widget->setStyleSheet("background: solid transparent");
+	part_s_widget->setObjectName("part_border_widget");
 
 	styled_widget* part_ne_widget = new styled_widget();
 	part_ne_widget->setFixedWidth(4);
 	part_ne_widget->setFixedHeight(4);
-	part_ne_widget->setStyleSheet("background: solid transparent");
+	part_ne_widget->setObjectName("part_border_widget");
 	styled_widget* part_e_widget = new styled_widget();
 	part_e_widget->setFixedWidth(4);
-	part_e_widget->setStyleSheet("background: solid transparent");
+	part_e_widget->setObjectName("part_border_widget");
 	styled_widget* part_se_widget = new styled_widget();
 	part_se_widget->setFixedWidth(4);
 	part_se_widget->setFixedHeight(4);
-	part_se_widget->setStyleSheet("background: solid transparent");
+	part_se_widget->setObjectName("part_border_widget");
 	
 
 	if (flag_contains(flags(), window_flags::resizable))
@@ -423,6 +457,8 @@ void styled_window::initialize_widget()
 
 void styled_window::show()
 {
+	trace_scope scope("styled_window::show");
+
 	ShowWindow(m_hwnd, SW_SHOW);
 	m_part_window_widget->show();
 	this->focus();
@@ -600,6 +636,16 @@ bool styled_window::eventFilter(QObject *obj, QEvent *ev)
 		//if (m_part_window_widget != nullptr)
 		//	qDebug() << obj << " Event: " << ev->type() << m_part_window_widget->sizeHint();
 
+		if (ev->type() == QEvent::LayoutRequest)
+		{
+			auto begin = layout_requests->begin.find(obj);
+			if (begin != layout_requests->begin.end())
+			{
+				trace_profiler::add_event("layout activation", obj->objectName(), begin.value(), trace_profiler::now() - begin.value());
+				layout_requests->begin.erase(begin);
+			}
+		}
+
 		if (ev->type() == QEvent::ShowToParent && flag_contains(m_internal_flags, internal_flags::adjust_size))
 		{
 			m_internal_flags &= ~internal_flags::adjust_size;
@@ -743,6 +789,16 @@ styled_window* styled_window::widget_to_window(QWidget* w)
 		return nullptr;
 	return it.value();
 }
+void styled_window::reapply_styles()
+{
+	for (auto window : m_all_windows)
+		window->m_part_window_widget->setUpdatesEnabled(false);
+
+	style_loader::reapply_styles();
+
+	for (auto window : m_all_windows)
+		window->m_part_window_widget->setUpdatesEnabled(true);
+}
 
 void styled_window::icon(const QPixmap& icon)
 {
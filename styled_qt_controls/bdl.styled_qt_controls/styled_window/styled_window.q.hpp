@@ -175,6 +175,12 @@ public:
 		* \returns The window that belongs to this widget
 		*/
 	static styled_window* widget_to_window(QWidget* w);
+	/*! \brief Applies the current theme_colors to all windows
+		*
+		* Updates of all windows are suspended while the stylesheets are replaced, so each window is repainted only once.
+		* Call this after util::theme_colors::load or after changing the colors in util::theme_colors.
+		*/
+	static void reapply_styles();
 
 	/*! \brief Enables the window for user interactions
 		*/
@@ -0,0 +1,60 @@
+/**************************************************************************************
+**
+** Copyright (C) 2016 Bernhard Steiner
+**
+** This file is part of the styled_qt_controls library
+**
+** This product is licensed under the GNU General Public License version 3.
+** The license is as published by the Free Software Foundation published at
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** Alternatively, this product is licensed under the GNU Lesser General Public
+** License version 3 for non-commercial use. The license is as published by the
+** Free Software Foundation published at https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** Feel free to contact us if you have any questions about licensing or want
+** to use the library in a commercial closed source product.
+**
+**************************************************************************************/
+
+
+#include <bdl.styled_qt_controls\styled_qt_controls.hpp>
+#include "async_task.q.hpp"
+
+using namespace bdl::styled_qt_controls::util;
+
+namespace
+{
+	class async_task_runnable : public QRunnable
+	{
+	public:
+		async_task_runnable(async_task* task, std::function<QVariant()> func) : m_task(task), m_func(func) { }
+
+		void run()
+		{
+			QVariant result = m_func();
+
+			//Queued, so the signal is emitted in the starting thread after the caller of async_task::run had the chance to connect to it
+			QMetaObject::invokeMethod(m_task, "task_finished", Qt::QueuedConnection, Q_ARG(QVariant, result));
+		}
+
+	private:
+		async_task* m_task;
+		std::function<QVariant()> m_func;
+	};
+}
+
+async_task::async_task() { }
+
+void async_task::task_finished(QVariant result)
+{
+	emit finished(result);
+	deleteLater();
+}
+
+async_task* async_task::run(std::function<QVariant()> func)
+{
+	auto task = new async_task();
+	QThreadPool::globalInstance()->start(new async_task_runnable(task, func));
+	return task;
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+/**************************************************************************************
+**
+** Copyright (C) 2016 Bernhard Steiner
+**
+** This file is part of the styled_qt_controls library
+**
+** This product is licensed under the GNU General Public License version 3.
+** The license is as published by the Free Software Foundation published at
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** Alternatively, this product is licensed under the GNU Lesser General Public
+** License version 3 for non-commercial use. The license is as published by the
+** Free Software Foundation published at https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** Feel free to contact us if you have any questions about licensing or want
+** to use the library in a commercial closed source product.
+**
+**************************************************************************************/
+
+
+#pragma once
+
+#include "..\styled_qt_controls.hpp"
+
+BEGIN_BDL_SQTC
+
+namespace util
+{
+	/*! \brief Runs a function on the global thread pool and reports the result back to the thread that started it
+		*
+		* \author bdl
+		*
+		* The task deletes itself after finished has been emitted. Since finished is emitted in the starting thread,
+		* receivers that are destroyed while the function is running are simply not called.
+		*/
+	class BDL_SQTC_EXPORT async_task : public QObject
+	{
+		Q_OBJECT;
+
+	public:
+		/*! \brief Starts a function on QThreadPool::globalInstance()
+			*
+			* \param func The function to run. It must not access widgets
+			* \returns The task. Connect to finished to receive the result
+			*/
+		static async_task* run(std::function<QVariant()> func);
+
+	signals:
+		/*! \brief Is emitted on the thread that started the task when the function has returned
+			*
+			* \param result The value returned by the function
+			*/
+		void finished(QVariant result);
+
+	private slots:
+		void task_finished(QVariant result);
+
+	private:
+		async_task();
+	};
+}
+
+END_BDL_SQTC
\ No newline at end of file
@@ -19,6 +19,8 @@
 
 #pragma once
 
-#define SET_STYLE(type,name)				void			name(type const &  value)	{ m_##name = value; style()->unpolish(this); style()->polish(this); }
+#include "style_state.hpp"
+
+#define SET_STYLE(type,name)				void			name(type const &  value)	{ if (m_##name == value) return; QVariant previous = QVariant::fromValue(m_##name); m_##name = value; bdl::styled_qt_controls::util::style_state::changed(this, #name, previous); }
 
 #define SET_NOTIFY_PROPERTY_CHANGED(type,name) void			name(type const &  value)	{ m_##name = value; emit property_changed(#name); }
\ No newline at end of file
@@ -47,4 +47,14 @@ void settings_group::clear_groups()
 		delete g;
 
 	m_groups.clear();
+}
+settings_group* settings_group::clone() const
+{
+	auto result = new settings_group(m_key);
+	result->m_values = m_values;
+
+	for (auto g : m_groups)
+		result->add_group(g->clone());
+
+	return result;
 }
\ No newline at end of file
@@ -67,6 +67,11 @@ namespace util
 		/*! \brief Removes all entries from the group
 			*/
 		void clear_groups();
+		/*! \brief Creates a deep copy of the group and all of its child groups
+			*
+			* \returns The copy. The caller takes ownership
+			*/
+		settings_group* clone() const;
 	};
 }
 
@@ -108,5 +108,45 @@ settings_group* settings_io::load_group(QDomElement* element)
 		group_element = group_element.nextSiblingElement();
 	}
 
+	return group;
+}
+void settings_io::write_group(QDataStream& stream, settings_group* group)
+{
+	stream << group->key() << (quint32)group->values().count();
+	for (auto it = group->values().constBegin(); it != group->values().constEnd(); ++it)
+		stream << it.key() << it.value();
+
+	stream << (quint32)group->groups().count();
+	for (auto child : group->groups())
+		write_group(stream, child);
+}
+settings_group* settings_io::read_group(QDataStream& stream, int max_depth)
+{
+	QString key;
+	quint32 value_count;
+	stream >> key >> value_count;
+
+	settings_group* group = new settings_group(key);
+	for (quint32 i = 0; i < value_count && stream.status() == QDataStream::Ok; i++)
+	{
+		QString value_key, value;
+		stream >> value_key >> value;
+		group->values().insert(value_key, value);
+	}
+
+	quint32 group_count = 0;
+	stream >> group_count;
+	if (group_count > 0 && max_depth <= 0)
+		stream.setStatus(QDataStream::ReadCorruptData);
+
+	for (quint32 i = 0; i < group_count && stream.status() == QDataStream::Ok; i++)
+		group->add_group(read_group(stream, max_depth - 1));
+
+	if (stream.status() != QDataStream::Ok)
+	{
+		delete group;
+		return nullptr;
+	}
+
 	return group;
 }
\ No newline at end of file
@@ -59,6 +59,20 @@ namespace util
 			* \returns The settings_group
 			*/
 		static settings_group* load_group(QDomElement* element);
+
+		/*! \brief Writes a group and all of its child groups in binary form to a QDataStream
+			*
+			* \param stream The target stream
+			* \param group The group that should be written
+			*/
+		static void write_group(QDataStream& stream, settings_group* group);
+		/*! \brief Reads a group that has been written with write_group
+			*
+			* \param stream The source stream
+			* \param max_depth Maximum number of nested group levels below the group. Deeper groups mark the stream as corrupted
+			* \returns The settings_group or nullptr when the stream is corrupted. The caller takes ownership
+			*/
+		static settings_group* read_group(QDataStream& stream, int max_depth = 64);
 	};
 }
 
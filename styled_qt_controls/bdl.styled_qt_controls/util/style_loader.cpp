@@ -20,29 +20,21 @@
 #include <bdl.styled_qt_controls\styled_qt_controls.hpp>
 #include "style_loader.hpp"
 #include "theme_colors.hpp"
+#include "theme_style.hpp"
+#include "trace_profiler.hpp"
 
 using namespace bdl::styled_qt_controls::util;
 
-style_loader::style_loader(QString path) : m_original_text("")
-{
-	set_replacement("@normal_highlight", theme_colors::normal_highlight);
-	set_replacement("@normal", theme_colors::normal);
-	set_replacement("@dark_highlight", theme_colors::dark_highlight);
-	set_replacement("@dark", theme_colors::dark);
-	set_replacement("@light_highlight", theme_colors::light_highlight);
-	set_replacement("@light", theme_colors::light);
-	set_replacement("@selection_highlight", theme_colors::selection_highlight);
-	set_replacement("@selection_dark", theme_colors::selection_dark);
-	set_replacement("@selection_border", theme_colors::selection_border);
-	set_replacement("@selection", theme_colors::selection);
-	set_replacement("@content_control", theme_colors::content_control);
-
-
-	set_replacement("@border", theme_colors::border);
-	set_replacement("@font_inactive", theme_colors::font_inactive);
-	set_replacement("@font", theme_colors::font);
-	set_replacement("@transparency_key", theme_colors::transparency_key);
+QHash<QString, QString> style_loader::m_style_cache;
+QHash<QWidget*, QStringList> style_loader::m_styled_widgets;
+QHash<QString, QString> style_loader::m_precompiled_styles;
+QHash<QString, QString> style_loader::m_precompiled_replacements;
+QList<QFile*> style_loader::m_theme_files;
+bool style_loader::m_application_style = false;
 
+style_loader::style_loader(QString path) : m_replacements(theme_replacements())
+{
+	trace_scope scope("style_loader::style_loader");
 	append_file(path);
 }
 style_loader::~style_loader()
@@ -51,30 +43,270 @@ style_loader::~style_loader()
 
 void style_loader::append_file(QString path)
 {
-	QFile file(path);
-	if (!file.open(QIODevice::ReadOnly))
+	m_files.push_back(path);
+}
+QString style_loader::style_string() const
+{
+	trace_scope scope("style_loader::style_string");
+	QString key = cache_key();
+
+	auto it = m_style_cache.find(key);
+	if (it != m_style_cache.end())
+		return it.value();
+
+	//Precompiled fragments are only valid as long as the colors have not been changed after loading the theme
+	bool use_precompiled = !m_precompiled_styles.isEmpty() && m_replacements == m_precompiled_replacements;
+
+	QString style;
+	for (auto& path : m_files)
+	{
+		//theme_style paints from the same rules, so it never has to be told about a selector twice
+		theme_style::add_file(path);
+
+		auto precompiled = use_precompiled ? m_precompiled_styles.find(path) : m_precompiled_styles.end();
+		if (precompiled != m_precompiled_styles.end())
+		{
+			style += precompiled.value();
+			continue;
+		}
+
+		QFile file(path);
+		if (!file.open(QIODevice::ReadOnly))
+		{
+			qFatal("Unable to load stylesheet file at %s", path.toUtf8().data());
+		}
+		else
+			style += replace_colors(QString(file.readAll()), path);
+	}
+
+	m_style_cache.insert(key, style);
+
+	return style;
+}
+void style_loader::apply_to(QWidget* widget) const
+{
+	if (!m_application_style)
+		apply_local(widget);
+}
+void style_loader::apply_local(QWidget* widget) const
+{
+	if (!m_styled_widgets.contains(widget))
+		QObject::connect(widget, &QObject::destroyed, [](QObject* obj) { m_styled_widgets.remove(static_cast<QWidget*>(obj)); });
+
+	m_styled_widgets.insert(widget, m_files);
+	QString style = style_string();
+
+	trace_scope scope("setStyleSheet", widget);
+	widget->setStyleSheet(style);
+}
+void style_loader::clear_cache()
+{
+	m_style_cache.clear();
+}
+void style_loader::reapply_styles()
+{
+	if (m_application_style)
 	{
-		qFatal("Unable to load stylesheet file at %s", path.toUtf8().data());
+		trace_scope scope("setStyleSheet", qApp);
+		qApp->setStyleSheet(application_style_string());
 	}
+
+	QHash<QString, QString> styles;
+	for (auto it = m_styled_widgets.begin(); it != m_styled_widgets.end(); it++)
+	{
+		QString files_key = it.value().join(";");
+		auto style_it = styles.find(files_key);
+
+		if (style_it == styles.end())
+		{
+			style_loader loader(it.value().first());
+			for (int i = 1; i < it.value().size(); i++)
+				loader.append_file(it.value()[i]);
+
+			style_it = styles.insert(files_key, loader.style_string());
+		}
+
+		trace_scope scope("setStyleSheet", it.key());
+		it.key()->setStyleSheet(style_it.value());
+	}
+}
+
+void style_loader::application_style(bool enabled)
+{
+	m_application_style = enabled;
+
+	trace_scope scope("setStyleSheet", qApp);
+
+	if (enabled)
+		qApp->setStyleSheet(application_style_string());
 	else
-		m_original_text += file.readAll();
+		qApp->setStyleSheet("");
 }
-QString style_loader::style_string() const
+bool style_loader::application_style()
+{
+	return m_application_style;
+}
+QString style_loader::application_style_string()
+{
+	//Order matters: control specific files have to follow the default styles of the window
+	style_loader loader(":/styled_window/styled_window.qss");
+	loader.append_file(":/styled_window/default_menu_style.qss");
+	loader.append_file(":/styled_window/default_styles.qss");
+	loader.append_file(":/styled_window/default_view_style.qss");
+	loader.append_file(":/styled_controls/styled_collapse_widget.qss");
+	loader.append_file(":/styled_controls/clearable_line_edit.qss");
+	loader.append_file(":/styled_controls/tree_combobox.qss");
+	loader.append_file(":/styled_dock_widget/styled_dock_widget.qss");
+	loader.append_file(":/styled_dock_widget/styled_dock_widget_top.qss");
+	loader.append_file(":/styled_dock_widget/styled_dock_widget_bottom.qss");
+	loader.append_file(":/styled_item_editor/styled_item_editor.qss");
+	loader.append_file(":/styled_path_widget/styled_path_widget.qss");
+	loader.append_file(":/styled_color_picker/styled_color_picker.qss");
+	return loader.style_string();
+}
+bool style_loader::load_theme(const QString& path)
 {
-	QString style = m_original_text;
+	QFile* file = new QFile(path);
+	const uchar* data = file->open(QIODevice::ReadOnly) ? file->map(0, file->size()) : nullptr;
+	if (data == nullptr)
+	{
+		qWarning() << "Unable to map theme file at" << path;
+		delete file;
+		return false;
+	}
 
-	for (auto it = m_replacements.cbegin(); it != m_replacements.cend(); ++it)
-		style.replace(it->first, it->second);
+	qint64 size = file->size();
+	auto read_uint = [data](qint64 offset) { return qFromLittleEndian<quint32>(data + offset); };
+	auto read_string = [data, size, read_uint](qint64 entry, QString& result)
+	{
+		qint64 offset = read_uint(entry);
+		qint64 length = read_uint(entry + 4);
+		if (offset % 2 != 0 || offset + length * 2 > size)
+			return false;
 
-	int idx = style.indexOf("@");
-	if (idx != -1)
-		qWarning() << "Found symbol @, have you misstyped a color name? ( text is \"" << style.mid(idx, min(20, style.length() - idx)) << "\"";
+		result = QString::fromRawData(reinterpret_cast<const QChar*>(data + offset), (int)length);
+		return true;
+	};
 
-	return style;
+	bool valid = size >= 16 && memcmp(data, "SQTT", 4) == 0 && read_uint(4) == 1;
+	qint64 color_count = valid ? read_uint(8) : 0;
+	qint64 style_count = valid ? read_uint(12) : 0;
+	valid = valid && 16 + color_count * 12 + style_count * 16 <= size;
+
+	QHash<QColor*, QColor> colors;
+	QHash<QString, QString> styles;
+
+	for (qint64 i = 0; valid && i < color_count; i++)
+	{
+		qint64 entry = 16 + i * 12;
+		QString name;
+		valid = read_string(entry, name);
+
+		QColor* target = valid ? theme_colors::color(name) : nullptr;
+		if (target != nullptr)
+			colors.insert(target, QColor::fromRgba(read_uint(entry + 8)));
+		else if (valid)
+			qWarning() << "Unknown color" << name << "in theme file" << path;
+	}
+	for (qint64 i = 0; valid && i < style_count; i++)
+	{
+		qint64 entry = 16 + color_count * 12 + i * 16;
+		QString style_path, text;
+		valid = read_string(entry, style_path) && read_string(entry + 8, text);
+		styles.insert(style_path, text);
+	}
+
+	if (!valid)
+	{
+		qWarning() << "Invalid theme file at" << path;
+		delete file;
+		return false;
+	}
+
+	//The strings point into the mapped file, so it stays mapped until the application exits
+	m_theme_files.push_back(file);
+
+	for (auto it = colors.begin(); it != colors.end(); it++)
+		*it.key() = it.value();
+
+	m_precompiled_styles = styles;
+	m_precompiled_replacements = theme_replacements();
+	clear_cache();
+
+	return true;
+}
+QString style_loader::cache_key() const
+{
+	QString key = m_files.join(";");
+
+	auto names = m_replacements.keys();
+	std::sort(names.begin(), names.end());
+	for (auto& name : names)
+		key += "|" + m_replacements[name];
+
+	return key;
+}
+QString style_loader::replace_colors(const QString& text, const QString& path) const
+{
+	QString result;
+	result.reserve(text.length() + text.length() / 4);
+
+	const QChar* data = text.constData();
+	int length = text.length();
+	int copy_start = 0;
+	int line = 1;
+	int line_start = 0;
+
+	for (int i = 0; i < length; i++)
+	{
+		if (data[i] == '\n')
+		{
+			line++;
+			line_start = i + 1;
+		}
+		else if (data[i] == '@')
+		{
+			//Read the identifier following the @
+			int end = i + 1;
+			while (end < length && (data[end].isLetterOrNumber() || data[end] == '_'))
+				end++;
+
+			auto it = m_replacements.find(text.mid(i + 1, end - i - 1));
+			if (it != m_replacements.end())
+			{
+				result.append(data + copy_start, i - copy_start);
+				result.append(it.value());
+				copy_start = end;
+			}
+			else
+				qWarning() << "Unknown color" << text.mid(i, end - i) << "in" << path << "at line" << line << "column" << (i - line_start + 1) << ", have you misstyped a color name?";
+
+			i = end - 1;
+		}
+	}
+
+	result.append(data + copy_start, length - copy_start);
+	return result;
 }
-void style_loader::set_replacement(QString key, QColor color)
-{	
-	m_replacements.push_back(QPair<QString, QString>(key, color_to_text(color)));
+style_loader::string_string_hashtable style_loader::theme_replacements()
+{
+	string_string_hashtable result;
+	result.insert("normal_highlight", color_to_text(theme_colors::normal_highlight));
+	result.insert("normal", color_to_text(theme_colors::normal));
+	result.insert("dark_highlight", color_to_text(theme_colors::dark_highlight));
+	result.insert("dark", color_to_text(theme_colors::dark));
+	result.insert("light_highlight", color_to_text(theme_colors::light_highlight));
+	result.insert("light", color_to_text(theme_colors::light));
+	result.insert("selection_highlight", color_to_text(theme_colors::selection_highlight));
+	result.insert("selection_dark", color_to_text(theme_colors::selection_dark));
+	result.insert("selection_border", color_to_text(theme_colors::selection_border));
+	result.insert("selection", color_to_text(theme_colors::selection));
+	result.insert("content_control", color_to_text(theme_colors::content_control));
+	result.insert("border", color_to_text(theme_colors::border));
+	result.insert("font_inactive", color_to_text(theme_colors::font_inactive));
+	result.insert("font", color_to_text(theme_colors::font));
+	result.insert("transparency_key", color_to_text(theme_colors::transparency_key));
+	return result;
 }
 
 QString style_loader::color_to_text(QColor color)
@@ -30,12 +30,20 @@ namespace util
 		* \author bdl
 		*
 		* Loads a file from the ressources and parses it for theme_color constants. All colors from theme_colors can be used with the "@[COLOR_NAME]" syntax.
+		* The text is scanned once for "@identifier" tokens, unknown tokens are reported with their line and column.
+		*
+		* Parsed style strings are cached process wide. The cache key consists of the ordered list of files and the current values of theme_colors,
+		* so each combination is only loaded and parsed once.
+		*
+		* Widgets styled through apply_to or apply_local are remembered, so reapply_styles can update them after theme_colors has changed.
+		*
+		* When a precompiled theme has been loaded with load_theme, its stylesheet fragments are used instead of the files with the same path.
 		*/
 	class BDL_SQTC_EXPORT style_loader
 	{
-		typedef QList<QPair<QString, QString>> string_string_hashtable;
+		typedef QHash<QString, QString> string_string_hashtable;
 		PROPERTY0(string_string_hashtable, replacements);
-		PROPERTY0(QString, original_text);
+		PROPERTY0(QStringList, files);
 
 	public:
 		/*! \brief Initializes a new instance of the style_loader class
@@ -57,6 +65,18 @@ namespace util
 			* \returns The parsed style string
 			*/
 		QString style_string() const;
+		/*! \brief Sets the parsed style string on a widget
+			*
+			* Does nothing when the application style is active, since the rules are already part of the application wide stylesheet.
+			*
+			* \param widget The widget on which the style should be set
+			*/
+		void apply_to(QWidget* widget) const;
+		/*! \brief Sets the parsed style string on a widget, even when the application style is active
+			*
+			* \param widget The widget on which the style should be set
+			*/
+		void apply_local(QWidget* widget) const;
 
 		/*! \brief Converts a QColor to a QString in the format rgba(R,G,B,A)
 			*
@@ -66,8 +86,64 @@ namespace util
 			*/
 		static QString color_to_text(QColor color);
 
+		/*! \brief Removes all parsed style strings from the cache
+			*
+			* The cache key contains the values of theme_colors, so this is not required when the theme changes. It only releases the memory
+			* of style strings that are not used anymore.
+			*/
+		static void clear_cache();
+		/*! \brief Parses the stylesheets again with the current theme_colors and sets them on all styled widgets
+			*
+			* Widgets that use the same files share one parsed string, switching back to a previously used theme only costs a cache lookup.
+			* Use styled_window::reapply_styles to suspend the updates of all windows during the change.
+			*/
+		static void reapply_styles();
+
+		/*! \brief Enables or disables the application style
+			*
+			* When enabled, the stylesheets of all controls in this library are merged into one stylesheet that is set on the QApplication.
+			* The controls then only rely on object names and dynamic properties and do not set local stylesheets, which avoids re-parsing
+			* and re-polishing whole subtrees for each control. Has to be called after the QApplication has been created and before any
+			* styled control is constructed.
+			*
+			* \param enabled True to install the merged stylesheet, False to remove it
+			*/
+		static void application_style(bool enabled);
+		/*! \brief Returns whether the application style is active
+			*
+			* \returns True when the merged stylesheet is installed on the QApplication, False otherwise
+			*/
+		static bool application_style();
+		/*! \brief Returns the merged stylesheet of all controls in this library
+			*
+			* \returns The parsed style string
+			*/
+		static QString application_style_string();
+
+		/*! \brief Loads a precompiled theme
+			*
+			* Precompiled themes are created from theme files by tools/theme_compiler. They contain the colors and the stylesheet fragments with all
+			* colors already substituted. The file is memory mapped and its strings are used without copying or parsing, it stays mapped until
+			* the application exits. The colors are written to theme_colors, the fragments are used as long as theme_colors is not changed
+			* afterwards. Call styled_window::reapply_styles when windows are already open.
+			*
+			* \param path Path to the precompiled theme
+			*
+			* \returns True when the theme has been loaded, False otherwise
+			*/
+		static bool load_theme(const QString& path);
+
 	private:
-		void set_replacement(QString key, QColor color);
+		static string_string_hashtable theme_replacements();
+		QString cache_key() const;
+		QString replace_colors(const QString& text, const QString& path) const;
+
+		static QHash<QString, QString> m_style_cache;
+		static QHash<QWidget*, QStringList> m_styled_widgets;
+		static QHash<QString, QString> m_precompiled_styles;
+		static QHash<QString, QString> m_precompiled_replacements;
+		static QList<QFile*> m_theme_files;
+		static bool m_application_style;
 	};
 }
 
@@ -0,0 +1,67 @@
+/**************************************************************************************
+**
+** Copyright (C) 2016 Bernhard Steiner
+**
+** This file is part of the styled_qt_controls library
+**
+** This product is licensed under the GNU General Public License version 3.
+** The license is as published by the Free Software Foundation published at
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** Alternatively, this product is licensed under the GNU Lesser General Public
+** License version 3 for non-commercial use. The license is as published by the
+** Free Software Foundation published at https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** Feel free to contact us if you have any questions about licensing or want
+** to use the library in a commercial closed source product.
+**
+**************************************************************************************/
+
+
+#include <bdl.styled_qt_controls\styled_qt_controls.hpp>
+#include "style_state.hpp"
+#include "theme_style.hpp"
+#include "trace_profiler.hpp"
+
+using namespace bdl::styled_qt_controls::util;
+
+void style_state::changed(QWidget* widget, const char* property, const QVariant& previous)
+{
+	auto before = theme_style::look(widget, property, previous);
+	auto after = theme_style::look(widget);
+
+	//QStyleSheetStyle keeps painting with the rules it matched when the widget was polished, which is fine as long as they look the same
+	bool repaint = before != nullptr && after != nullptr && before->exact && after->exact && before->polish_key == after->polish_key
+		&& (before->paint_key == after->paint_key || (theme_style::draws(widget, before) && theme_style::draws(widget, after) && theme_style::paints_completely(widget)));
+
+	if (repaint)
+	{
+		apply_properties(widget, *before, *after);
+		widget->update();
+	}
+	else
+	{
+		trace_scope scope("polish", widget);
+		widget->style()->unpolish(widget);
+		widget->style()->polish(widget);
+	}
+}
+
+void style_state::apply_properties(QWidget* widget, const theme_style_look& before, const theme_style_look& after)
+{
+	//Polishing would set the qproperty- values of the new state, so this has to be done here instead
+	for (auto& property : after.properties)
+	{
+		if (before.properties.contains(property))
+			continue;
+
+		if (widget->property(property.first.data()).userType() == QMetaType::QColor)
+		{
+			auto color = theme_style::color(property.second);
+			if (color != nullptr)
+				widget->setProperty(property.first.data(), *color);
+		}
+		else
+			widget->setProperty(property.first.data(), property.second);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+/**************************************************************************************
+**
+** Copyright (C) 2016 Bernhard Steiner
+**
+** This file is part of the styled_qt_controls library
+**
+** This product is licensed under the GNU General Public License version 3.
+** The license is as published by the Free Software Foundation published at
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** Alternatively, this product is licensed under the GNU Lesser General Public
+** License version 3 for non-commercial use. The license is as published by the
+** Free Software Foundation published at https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** Feel free to contact us if you have any questions about licensing or want
+** to use the library in a commercial closed source product.
+**
+**************************************************************************************/
+
+
+#pragma once
+
+#include "..\styled_qt_controls.hpp"
+
+BEGIN_BDL_SQTC
+
+namespace util
+{
+	struct theme_style_look;
+
+	/*! \brief Updates widgets after a property that is used for stylesheet selectors has changed
+		*
+		* \author bdl
+		*
+		* Re-polishing a widget makes Qt match all stylesheet rules against it again and can trigger a relayout. The looks of the widget
+		* before and after the change are resolved by theme_style, which caches them per combination of matching rules, so checking a state
+		* change does not walk any stylesheet. The widget is only repainted when both looks have the same geometry, fonts and text colors, and
+		* either paint identically or are both painted completely by theme_style. In all other cases it is re-polished.
+		*
+		* Only stylesheets known to theme_style are considered: the ones loaded with style_loader and the ones added with
+		* theme_style::add_stylesheet. Widgets with rules from other stylesheets are always re-polished.
+		*/
+	class BDL_SQTC_EXPORT style_state
+	{
+	public:
+		/*! \brief Re-polishes or repaints a widget after one of its properties has changed
+			*
+			* \param widget The widget
+			* \param property Name of the property that has changed
+			* \param previous Value of the property before the change
+			*/
+		static void changed(QWidget* widget, const char* property, const QVariant& previous);
+
+	private:
+		static void apply_properties(QWidget* widget, const theme_style_look& before, const theme_style_look& after);
+	};
+}
+
+END_BDL_SQTC
\ No newline at end of file
@@ -22,22 +22,99 @@
 
 using namespace bdl::styled_qt_controls::util;
 
-QColor theme_colors::normal(43,43,43);
-QColor theme_colors::normal_highlight(66,66,66);
-QColor theme_colors::dark(31,31,31);
-QColor theme_colors::dark_highlight(40,40,40);
-QColor theme_colors::light(63, 63, 63);
-QColor theme_colors::light_highlight(97, 97, 97);
-QColor theme_colors::content_control(36, 36, 36);
+//The default colors are generated from themes/dark_orange.theme by the custom build step of the theme
+#include "theme_colors.generated.hpp"
 
-QColor theme_colors::selection(218, 91, 10);
-QColor theme_colors::selection_highlight(255, 174, 123);
-QColor theme_colors::selection_border(109, 46, 5);
-QColor theme_colors::selection_dark(167, 72, 9);
+static QHash<QString, QColor*> color_table()
+{
+	QHash<QString, QColor*> result;
+	result.insert("normal", &theme_colors::normal);
+	result.insert("normal_highlight", &theme_colors::normal_highlight);
+	result.insert("dark", &theme_colors::dark);
+	result.insert("dark_highlight", &theme_colors::dark_highlight);
+	result.insert("light", &theme_colors::light);
+	result.insert("light_highlight", &theme_colors::light_highlight);
+	result.insert("content_control", &theme_colors::content_control);
+	result.insert("selection", &theme_colors::selection);
+	result.insert("selection_highlight", &theme_colors::selection_highlight);
+	result.insert("selection_border", &theme_colors::selection_border);
+	result.insert("selection_dark", &theme_colors::selection_dark);
+	result.insert("border", &theme_colors::border);
+	result.insert("font", &theme_colors::font);
+	result.insert("font_inactive", &theme_colors::font_inactive);
+	result.insert("transparency_key", &theme_colors::transparency_key);
+	return result;
+}
+//Same grammar as the theme compiler: "#rrggbb" or "#aarrggbb"
+static bool parse_color(const QString& text, QColor& result)
+{
+	if (!text.startsWith('#') || (text.length() != 7 && text.length() != 9))
+		return false;
 
-QColor theme_colors::border(20, 20, 20);
+	QRgb value = 0;
+	for (int i = 1; i < text.length(); i++)
+	{
+		ushort c = text[i].unicode();
+		int digit = c >= '0' && c <= '9' ? c - '0' : c >= 'a' && c <= 'f' ? c - 'a' + 10 : c >= 'A' && c <= 'F' ? c - 'A' + 10 : -1;
+		if (digit < 0)
+			return false;
 
-QColor theme_colors::font(242,242,242);
-QColor theme_colors::font_inactive(153, 153, 153);
+		value = value * 16 + digit;
+	}
 
-QColor theme_colors::transparency_key(255, 250, 255);
\ No newline at end of file
+	result = QColor::fromRgba(text.length() == 7 ? (value | 0xff000000) : value);
+	return true;
+}
+
+QColor* theme_colors::color(const QString& name)
+{
+	static QHash<QString, QColor*> colors = color_table();
+	return colors.value(name, nullptr);
+}
+
+bool theme_colors::load(const QString& path)
+{
+	QFile file(path);
+	if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+	{
+		qWarning() << "Unable to load theme file at" << path;
+		return false;
+	}
+
+	QHash<QColor*, QColor> loaded;
+	bool in_colors = true;
+	int line_number = 0;
+
+	while (!file.atEnd())
+	{
+		line_number++;
+		QString line = QString(file.readLine()).trimmed();
+		if (line.isEmpty() || line.startsWith(';'))
+			continue;
+
+		if (line.startsWith('[') && line.endsWith(']'))
+		{
+			in_colors = line == "[colors]";
+			continue;
+		}
+		if (!in_colors)
+			continue;
+
+		int separator = line.indexOf('=');
+		QColor* target = separator < 0 ? nullptr : color(line.left(separator).trimmed());
+		QColor value;
+
+		if (target == nullptr || !parse_color(line.mid(separator + 1).trimmed(), value))
+		{
+			qWarning() << "Invalid entry in theme file" << path << "at line" << line_number << ":" << line;
+			return false;
+		}
+
+		loaded.insert(target, value);
+	}
+
+	for (auto it = loaded.begin(); it != loaded.end(); it++)
+		*it.key() = it.value();
+
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,17 @@
+//Generated by tools/theme_compiler from dark_orange.theme. Do not edit, change the theme file instead
+
+QColor theme_colors::normal(43, 43, 43, 255);
+QColor theme_colors::normal_highlight(66, 66, 66, 255);
+QColor theme_colors::dark(31, 31, 31, 255);
+QColor theme_colors::dark_highlight(40, 40, 40, 255);
+QColor theme_colors::light(63, 63, 63, 255);
+QColor theme_colors::light_highlight(97, 97, 97, 255);
+QColor theme_colors::content_control(36, 36, 36, 255);
+QColor theme_colors::selection(218, 91, 10, 255);
+QColor theme_colors::selection_highlight(255, 174, 123, 255);
+QColor theme_colors::selection_border(109, 46, 5, 255);
+QColor theme_colors::selection_dark(167, 72, 9, 255);
+QColor theme_colors::border(20, 20, 20, 255);
+QColor theme_colors::font(242, 242, 242, 255);
+QColor theme_colors::font_inactive(153, 153, 153, 255);
+QColor theme_colors::transparency_key(255, 250, 255, 255);
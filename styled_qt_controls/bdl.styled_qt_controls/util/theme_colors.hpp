@@ -26,6 +26,8 @@ BEGIN_BDL_SQTC
 namespace util
 {
 	/*! \brief Contains color constants used in the dark orange theme
+		*
+		* The default values are generated from themes/dark_orange.theme by tools/theme_compiler.
 		*
 		* \author bdl
 		*/
@@ -66,6 +68,28 @@ namespace util
 			
 		//! Transparency key of the underlying window. Do not use this color when you don't want the widget to be transparent.
 		static QColor transparency_key;
+
+		/*! \brief Returns the color with the given name
+			*
+			* \param name Name of the color, e.g. "selection"
+			*
+			* \returns A pointer to the color or nullptr when there is no color with this name
+			*/
+		static QColor* color(const QString& name);
+
+		/*! \brief Loads the colors of a theme file
+			*
+			* Each line in the [colors] section of the file has the form "name = color", where name is one of the colors in this class and
+			* color is "#rrggbb" or "#aarrggbb" (e.g. "#ff8000" or "#80ff8000"), like in the theme compiler. Named colors are rejected. Lines
+			* before the first section are treated as colors as well, other sections are skipped. Empty lines and lines starting with ';' are ignored, colors that are not listed
+			* keep their current value. Nothing is changed when the file contains an invalid line.
+			* Call styled_window::reapply_styles afterwards to update all open windows.
+			*
+			* \param path Path to the theme file
+			*
+			* \returns True when the theme has been loaded, False otherwise
+			*/
+		static bool load(const QString& path);
 	};
 }
 
@@ -0,0 +1,727 @@
+/**************************************************************************************
+**
+** Copyright (C) 2016 Bernhard Steiner
+**
+** This file is part of the styled_qt_controls library
+**
+** This product is licensed under the GNU General Public License version 3.
+** The license is as published by the Free Software Foundation published at
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** Alternatively, this product is licensed under the GNU Lesser General Public
+** License version 3 for non-commercial use. The license is as published by the
+** Free Software Foundation published at https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** Feel free to contact us if you have any questions about licensing or want
+** to use the library in a commercial closed source product.
+**
+**************************************************************************************/
+
+
+#include <bdl.styled_qt_controls\styled_qt_controls.hpp>
+#include "theme_style.hpp"
+#include "theme_colors.hpp"
+
+using namespace bdl::styled_qt_controls::util;
+
+QVector<theme_style::rule> theme_style::m_rules;
+QSet<QString> theme_style::m_files;
+QHash<theme_style::class_name_pair, QVector<int>> theme_style::m_candidates;
+QHash<QByteArray, theme_style_look*> theme_style::m_looks;
+QHash<QRgb, QColor*> theme_style::m_literal_colors;
+bool theme_style::m_enabled = false;
+bool theme_style::m_installed = false;
+
+namespace
+{
+	enum edge { left_edge, top_edge, right_edge, bottom_edge };
+
+	//Splits a value at whitespace, except inside of parentheses like in "url(...)" or "rgb(...)"
+	QStringList tokens(const QString& value)
+	{
+		QStringList result;
+		QString current;
+		int depth = 0;
+
+		for (auto c : value)
+		{
+			if (c == '(')
+				depth++;
+			else if (c == ')')
+				depth--;
+
+			if (c.isSpace() && depth == 0)
+			{
+				if (!current.isEmpty())
+					result.push_back(current);
+				current.clear();
+			}
+			else
+				current += c;
+		}
+		if (!current.isEmpty())
+			result.push_back(current);
+
+		return result;
+	}
+	//Returns the path of "url(path)", a null string when the value is no url
+	QString url(const QString& value)
+	{
+		if (!value.startsWith("url(") || !value.endsWith(')'))
+			return QString();
+
+		QString path = value.mid(4, value.length() - 5).trimmed();
+		if (path.length() >= 2 && (path[0] == '"' || path[0] == '\''))
+			path = path.mid(1, path.length() - 2);
+		return path;
+	}
+	bool parse_length(const QString& value, int& result)
+	{
+		bool valid;
+		result = (value.endsWith("px") ? value.left(value.length() - 2) : value).toInt(&valid);
+		return valid;
+	}
+	//Declarations that change how QStyleSheetStyle paints the background and the border of a widget
+	bool is_paint_declaration(const QString& name)
+	{
+		return name.startsWith("background") || name.startsWith("border") || name.startsWith("margin") || name == "image";
+	}
+}
+
+theme_style::theme_style(QStyle* style) : QProxyStyle(style)
+{
+}
+theme_style::~theme_style()
+{
+}
+
+void theme_style::drawPrimitive(PrimitiveElement element, const QStyleOption* option, QPainter* painter, const QWidget* widget) const
+{
+	if (element == PE_Widget && widget != nullptr && draw_widget(option, painter, widget))
+		return;
+
+	QProxyStyle::drawPrimitive(element, option, painter, widget);
+}
+
+void theme_style::enabled(bool enabled)
+{
+	bool was_enabled = m_enabled;
+	m_enabled = enabled;
+
+	if (enabled && !m_installed)
+	{
+		m_installed = true;
+		qApp->setStyle(new theme_style());
+	}
+
+	if (was_enabled && !enabled)
+	{
+		//The stylesheets may not know the current state of widgets that have been painted here
+		for (auto widget : QApplication::allWidgets())
+		{
+			widget->style()->unpolish(widget);
+			widget->style()->polish(widget);
+		}
+	}
+
+	for (auto widget : QApplication::topLevelWidgets())
+		widget->update();
+}
+bool theme_style::enabled()
+{
+	return m_enabled;
+}
+
+void theme_style::add_file(const QString& path)
+{
+	if (m_files.contains(path))
+		return;
+	m_files.insert(path);
+
+	QFile file(path);
+	if (!file.open(QIODevice::ReadOnly))
+	{
+		qWarning() << "Unable to load stylesheet file at" << path;
+		return;
+	}
+
+	add_stylesheet(QString::fromUtf8(file.readAll()));
+}
+void theme_style::add_stylesheet(const QString& style_sheet)
+{
+	parse(style_sheet);
+
+	m_candidates.clear();
+	qDeleteAll(m_looks);
+	m_looks.clear();
+}
+
+const theme_style_look* theme_style::look(const QWidget* widget, const char* property, const QVariant& value)
+{
+	auto& indices = candidates(widget);
+	if (indices.isEmpty())
+		return nullptr;
+
+	QByteArray key;
+	for (int index : indices)
+	{
+		auto& r = m_rules[index];
+		if (matches(r, r.parts.size() - 1, widget, widget, property, value))
+			key.append(reinterpret_cast<const char*>(&index), sizeof(index));
+	}
+
+	auto it = m_looks.find(key);
+	if (it == m_looks.end())
+		it = m_looks.insert(key, resolve(key));
+
+	return it.value();
+}
+const QColor* theme_style::color(const QString& value)
+{
+	if (value.startsWith('@'))
+		return theme_colors::color(value.mid(1));
+
+	QColor result;
+	if (value.startsWith("rgb"))
+	{
+		int open = value.indexOf('(');
+		int close = value.lastIndexOf(')');
+		QStringList channels = open < 0 || close < open ? QStringList() : value.mid(open + 1, close - open - 1).split(',');
+
+		int rgba[4] = { 0, 0, 0, 255 };
+		bool valid = channels.size() == (value.startsWith("rgba") ? 4 : 3);
+		for (int i = 0; valid && i < channels.size(); i++)
+			rgba[i] = channels[i].trimmed().toInt(&valid);
+
+		if (valid)
+			result.setRgb(rgba[0], rgba[1], rgba[2], rgba[3]);
+	}
+	else
+		result.setNamedColor(value);
+
+	if (!result.isValid())
+		return nullptr;
+
+	//Literal colors are kept until the application exits, so they can be referenced like the colors of theme_colors
+	auto it = m_literal_colors.find(result.rgba());
+	if (it == m_literal_colors.end())
+		it = m_literal_colors.insert(result.rgba(), new QColor(result));
+
+	return it.value();
+}
+
+bool theme_style::draws(const QWidget* widget, const theme_style_look* look)
+{
+	return m_enabled && look != nullptr && look->exact && look->specific && look->paintable && !has_inline_style(widget);
+}
+bool theme_style::paints_completely(const QWidget* widget)
+{
+	const char* name = widget->metaObject()->className();
+	if (qstrcmp(name, "bdl::styled_qt_controls::styled_frame") == 0 || qstrcmp(name, "bdl::styled_qt_controls::styled_gradient_frame") == 0
+		|| qstrcmp(name, "bdl::styled_qt_controls::styled_widget") == 0 || qstrcmp(name, "bdl::styled_qt_controls::styled_collapse_widget") == 0)
+		return true;
+
+	auto button = qobject_cast<const QPushButton*>(widget);
+	return button != nullptr && qstrcmp(name, "bdl::styled_qt_controls::styled_pushbutton") == 0 && button->text().isEmpty() && button->icon().isNull()
+		&& button->menu() == nullptr && button->focusPolicy() == Qt::NoFocus;
+}
+bool theme_style::draw_widget(const QStyleOption* option, QPainter* painter, const QWidget* widget)
+{
+	if (!m_enabled)
+		return false;
+
+	auto current = look(widget);
+	if (!draws(widget, current))
+		return false;
+
+	const QRect& r = option->rect;
+	auto& widths = current->border_widths;
+	auto& colors = current->border_colors;
+
+	if (current->background != nullptr)
+		painter->fillRect(r, *current->background);
+
+	if (widths[left_edge] > 0 && colors[left_edge] != nullptr)
+		painter->fillRect(r.left(), r.top(), widths[left_edge], r.height(), *colors[left_edge]);
+	if (widths[top_edge] > 0 && colors[top_edge] != nullptr)
+		painter->fillRect(r.left(), r.top(), r.width(), widths[top_edge], *colors[top_edge]);
+	if (widths[right_edge] > 0 && colors[right_edge] != nullptr)
+		painter->fillRect(r.right() - widths[right_edge] + 1, r.top(), widths[right_edge], r.height(), *colors[right_edge]);
+	if (widths[bottom_edge] > 0 && colors[bottom_edge] != nullptr)
+		painter->fillRect(r.left(), r.bottom() - widths[bottom_edge] + 1, r.width(), widths[bottom_edge], *colors[bottom_edge]);
+
+	if (!current->image.isNull())
+	{
+		QRect inner = r.adjusted(widths[left_edge], widths[top_edge], -widths[right_edge], -widths[bottom_edge]);
+		QSize size = current->image.size() / current->image.devicePixelRatio();
+		painter->drawPixmap(QStyle::alignedRect(option->direction, Qt::AlignCenter, size, inner), current->image);
+	}
+
+	return true;
+}
+
+void theme_style::parse(const QString& style_sheet)
+{
+	//Comments are removed first, so they can appear anywhere
+	QString text;
+	text.reserve(style_sheet.length());
+	int length = style_sheet.length();
+
+	for (int i = 0; i < length;)
+	{
+		if (style_sheet[i] == '/' && i + 1 < length && style_sheet[i + 1] == '*')
+		{
+			int end = style_sheet.indexOf("*/", i + 2);
+			i = end < 0 ? length : end + 2;
+		}
+		else if (style_sheet[i] == QChar(0xfeff))
+			i++;
+		else
+			text += style_sheet[i++];
+	}
+
+	int start = 0;
+	int open;
+	while ((open = text.indexOf('{', start)) >= 0)
+	{
+		int close = text.indexOf('}', open);
+		if (close < 0)
+			close = text.length();
+
+		QList<QPair<QString, QString>> declarations;
+		for (auto& declaration : text.mid(open + 1, close - open - 1).split(';'))
+		{
+			int colon = declaration.indexOf(':');
+			if (colon > 0)
+				declarations.push_back(qMakePair(declaration.left(colon).trimmed(), declaration.mid(colon + 1).trimmed()));
+		}
+
+		for (auto& selector : text.mid(start, open - start).split(','))
+		{
+			rule r;
+			r.supported = parse_selector(selector.trimmed(), r);
+			r.declarations = declarations;
+
+			if (!r.parts.isEmpty())
+				m_rules.push_back(r);
+		}
+
+		start = close + 1;
+	}
+}
+bool theme_style::parse_selector(const QString& selector, rule& result)
+{
+	result.subcontrol = false;
+	result.specificity = 0;
+
+	bool supported = true;
+	bool child = false;
+	int length = selector.length();
+	int i = 0;
+
+	while (i < length)
+	{
+		if (selector[i].isSpace())
+		{
+			i++;
+			continue;
+		}
+		if (selector[i] == '>')
+		{
+			child = true;
+			i++;
+			continue;
+		}
+
+		int start = i;
+		int depth = 0;
+		while (i < length && (depth > 0 || (!selector[i].isSpace() && selector[i] != '>')))
+		{
+			if (selector[i] == '[')
+				depth++;
+			else if (selector[i] == ']')
+				depth--;
+			i++;
+		}
+
+		if (!result.parts.isEmpty())
+			result.parts.last().child = child;
+		child = false;
+
+		selector_part part;
+		part.pseudo = false;
+		part.child = false;
+		supported = parse_part(selector.mid(start, i - start), part, result) && supported;
+		result.parts.push_back(part);
+	}
+
+	//Qt does not re-polish a widget when the pseudo state of one of its ancestors changes, so these are not tracked either
+	for (int p = 0; p + 1 < result.parts.size(); p++)
+		supported = supported && !result.parts[p].pseudo;
+
+	return supported && !child;
+}
+bool theme_style::parse_part(const QString& text, selector_part& part, rule& result)
+{
+	int length = text.length();
+	int i = 0;
+
+	while (i < length && text[i] != '#' && text[i] != '[' && text[i] != ':')
+	{
+		//Class selectors like ".QFrame" and sibling combinators are not supported
+		if (!text[i].isLetterOrNumber() && text[i] != '_' && text[i] != '-' && text[i] != '*')
+			return false;
+		i++;
+	}
+
+	QString type = text.left(i);
+	if (!type.isEmpty() && type != "*")
+	{
+		//Namespaces are written with "--" in stylesheets
+		part.type = type.replace("--", "::").toLatin1();
+		result.specificity += 1;
+	}
+
+	while (i < length)
+	{
+		if (text[i] == '#')
+		{
+			int end = i + 1;
+			while (end < length && (text[end].isLetterOrNumber() || text[end] == '_' || text[end] == '-'))
+				end++;
+
+			part.id = text.mid(i + 1, end - i - 1);
+			result.specificity += 10000;
+			i = end;
+		}
+		else if (text[i] == '[')
+		{
+			int end = text.indexOf(']', i);
+			if (end < 0)
+				return false;
+
+			QString condition = text.mid(i + 1, end - i - 1);
+			int equals = condition.indexOf('=');
+			if (equals < 0)
+				part.properties.push_back(qMakePair(condition.trimmed().toLatin1(), QString()));
+			else
+			{
+				//Only exact matches are supported, not "~=" and the like
+				QString name = condition.left(equals).trimmed();
+				if (name.isEmpty() || !(name[name.length() - 1].isLetterOrNumber() || name[name.length() - 1] == '_'))
+					return false;
+
+				QString value = condition.mid(equals + 1).trimmed();
+				if (value.length() >= 2 && (value[0] == '"' || value[0] == '\''))
+					value = value.mid(1, value.length() - 2);
+
+				part.properties.push_back(qMakePair(name.toLatin1(), value));
+			}
+
+			result.specificity += 100;
+			i = end + 1;
+		}
+		else if (text[i] == ':')
+		{
+			bool subcontrol = i + 1 < length && text[i + 1] == ':';
+			i += subcontrol ? 2 : 1;
+			if (i < length && text[i] == '!')
+				i++;
+			while (i < length && (text[i].isLetterOrNumber() || text[i] == '_' || text[i] == '-'))
+				i++;
+
+			if (subcontrol)
+			{
+				result.subcontrol = true;
+				result.specificity += 1;
+			}
+			else
+			{
+				part.pseudo = true;
+				result.specificity += 100;
+			}
+		}
+		else
+			return false;
+	}
+
+	return true;
+}
+
+const QVector<int>& theme_style::candidates(const QWidget* widget)
+{
+	class_name_pair key(widget->metaObject(), widget->objectName());
+
+	auto it = m_candidates.find(key);
+	if (it != m_candidates.end())
+		return it.value();
+
+	QVector<int> result;
+	for (int i = 0; i < m_rules.size(); i++)
+	{
+		auto& subject = m_rules[i].parts.last();
+		if ((subject.id.isEmpty() || subject.id == key.second) && (subject.type.isEmpty() || widget->inherits(subject.type.data())))
+			result.push_back(i);
+	}
+
+	return m_candidates.insert(key, result).value();
+}
+bool theme_style::matches(const rule& r, int part, const QWidget* widget, const QWidget* subject, const char* property, const QVariant& value)
+{
+	if (!r.supported)
+		return true;
+
+	//Class and object name of the subject have already been checked by candidates
+	auto& p = r.parts[part];
+	if (widget != subject && ((!p.id.isEmpty() && p.id != widget->objectName()) || (!p.type.isEmpty() && !widget->inherits(p.type.data()))))
+		return false;
+
+	for (auto& condition : p.properties)
+	{
+		QVariant current = widget == subject && property != nullptr && condition.first == property ? value : widget->property(condition.first.data());
+		if (condition.second.isNull() ? !current.isValid() : current.toString() != condition.second)
+			return false;
+	}
+
+	if (part == 0)
+		return true;
+
+	const QWidget* parent = widget->parentWidget();
+	if (r.parts[part - 1].child)
+		return parent != nullptr && matches(r, part - 1, parent, subject, property, value);
+
+	for (; parent != nullptr; parent = parent->parentWidget())
+	{
+		if (matches(r, part - 1, parent, subject, property, value))
+			return true;
+	}
+
+	return false;
+}
+theme_style_look* theme_style::resolve(const QByteArray& key)
+{
+	QVector<int> indices(key.size() / sizeof(int));
+	memcpy(indices.data(), key.constData(), key.size());
+
+	//Rules with a higher specificity win, rules with the same specificity are applied in the order they have been added
+	std::stable_sort(indices.begin(), indices.end(), [](int a, int b) { return m_rules[a].specificity < m_rules[b].specificity; });
+
+	auto look = new theme_style_look();
+	look->exact = true;
+	look->specific = false;
+	look->paintable = true;
+	look->background = nullptr;
+	for (int i = 0; i < 4; i++)
+	{
+		look->border_colors[i] = nullptr;
+		look->border_widths[i] = 0;
+	}
+
+	QString image;
+	bool repeat = true;
+	bool centered = false;
+	int padding[4] = { 0, 0, 0, 0 };
+	QMap<QString, QString> polish;
+	QString pseudo_paint;
+	QString pseudo_polish;
+
+	//Returns whether a rule that is applied after the one at position sets a shorthand property and thereby overrides it
+	auto overridden = [&indices](int position, const QString& shorthand)
+	{
+		for (int i = position + 1; i < indices.size(); i++)
+		{
+			auto& r = m_rules[indices[i]];
+			if (!r.supported || r.subcontrol || r.parts.last().pseudo)
+				continue;
+
+			for (auto& declaration : r.declarations)
+			{
+				if (declaration.first == shorthand)
+					return true;
+			}
+		}
+		return false;
+	};
+
+	for (int position = 0; position < indices.size(); position++)
+	{
+		auto& r = m_rules[indices[position]];
+		if (!r.supported)
+		{
+			look->exact = false;
+			continue;
+		}
+
+		//Pseudo states are evaluated by QStyleSheetStyle while painting. They are harmless for painting here as long as later rules override them
+		if (r.subcontrol || r.parts.last().pseudo)
+		{
+			bool paints = false;
+			bool polishes = false;
+			for (auto& declaration : r.declarations)
+			{
+				if (declaration.first.startsWith("qproperty-"))
+					continue;
+
+				if (r.subcontrol || !is_paint_declaration(declaration.first))
+				{
+					polishes = true;
+					continue;
+				}
+
+				paints = true;
+				QString shorthand = declaration.first.startsWith("background") ? "background" : declaration.first.startsWith("border") ? "border" : QString();
+				if (shorthand.isNull() || !overridden(position, shorthand))
+					look->paintable = false;
+			}
+
+			if (paints)
+				pseudo_paint += QString("%1;").arg(indices[position]);
+			if (polishes)
+				pseudo_polish += QString("%1;").arg(indices[position]);
+			continue;
+		}
+
+		look->specific = look->specific || !r.parts.last().id.isEmpty();
+
+		for (auto& declaration : r.declarations)
+		{
+			const QString& name = declaration.first;
+			const QString& value = declaration.second;
+
+			if (name.startsWith("qproperty-"))
+			{
+				QByteArray property = name.mid(10).toLatin1();
+				auto it = std::find_if(look->properties.begin(), look->properties.end(), [&property](const QPair<QByteArray, QString>& p) { return p.first == property; });
+				if (it != look->properties.end())
+					it->second = value;
+				else
+					look->properties.push_back(qMakePair(property, value));
+			}
+			else if (name == "background")
+			{
+				//The shorthand resets everything it does not set
+				look->background = nullptr;
+				image.clear();
+				repeat = true;
+				centered = false;
+
+				for (auto& token : tokens(value))
+				{
+					if (token == "solid" || token == "none")
+						continue;
+					else if (!url(token).isNull())
+						image = url(token);
+					else if (token.startsWith("repeat") || token == "no-repeat")
+						repeat = token != "no-repeat";
+					else if (token == "center")
+						centered = true;
+					else if (color(token) != nullptr)
+						look->background = color(token);
+					else
+						look->paintable = false;
+				}
+			}
+			else if (name == "background-color")
+			{
+				look->background = color(value);
+				look->paintable = look->paintable && look->background != nullptr;
+			}
+			else if (name == "background-image")
+			{
+				image = value == "none" ? QString() : url(value);
+				look->paintable = look->paintable && (value == "none" || !image.isNull());
+			}
+			else if (name == "background-repeat")
+				repeat = value != "no-repeat";
+			else if (name == "background-position")
+				centered = value == "center" || value == "center center";
+			else if (name == "border" || name == "border-left" || name == "border-top" || name == "border-right" || name == "border-bottom")
+			{
+				//Without a style, Qt does not draw the border and treats its width as 0
+				int width = 0;
+				bool solid = false;
+				const QColor* border = nullptr;
+
+				for (auto& token : tokens(value))
+				{
+					if (token == "solid")
+						solid = true;
+					else if (token == "none" || parse_length(token, width))
+						continue;
+					else if (color(token) != nullptr)
+						border = color(token);
+					else
+						look->paintable = false;
+				}
+
+				for (int edge = left_edge; edge <= bottom_edge; edge++)
+				{
+					static const char* edge_names[] = { "border-left", "border-top", "border-right", "border-bottom" };
+					if (name == "border" || name == edge_names[edge])
+					{
+						look->border_widths[edge] = solid ? width : 0;
+						look->border_colors[edge] = solid ? border : nullptr;
+					}
+				}
+			}
+			else if (name == "padding" || name == "padding-left" || name == "padding-top" || name == "padding-right" || name == "padding-bottom")
+			{
+				QStringList values = tokens(value);
+				int parsed[4];
+				bool valid = !values.isEmpty() && values.size() <= (name == "padding" ? 4 : 1);
+				for (int i = 0; valid && i < values.size(); i++)
+					valid = parse_length(values[i], parsed[i]);
+
+				if (!valid)
+					polish.insert(name, value);
+				else if (name == "padding")
+				{
+					//Same order as in CSS: top, right, bottom, left, missing values are taken from the opposite side
+					int top = parsed[0];
+					int right = values.size() > 1 ? parsed[1] : top;
+					int bottom = values.size() > 2 ? parsed[2] : top;
+					int left = values.size() > 3 ? parsed[3] : right;
+
+					padding[left_edge] = left;
+					padding[top_edge] = top;
+					padding[right_edge] = right;
+					padding[bottom_edge] = bottom;
+				}
+				else
+					padding[name == "padding-left" ? left_edge : name == "padding-top" ? top_edge : name == "padding-right" ? right_edge : bottom_edge] = parsed[0];
+			}
+			else
+			{
+				if (is_paint_declaration(name))
+					look->paintable = false;
+				polish.insert(name, value);
+			}
+		}
+	}
+
+	if (!image.isEmpty())
+	{
+		look->image = QPixmap(image);
+		look->paintable = look->paintable && !repeat && centered;
+	}
+
+	look->paint_key = QString("%1;").arg((quintptr)look->background, 0, 16);
+	for (int edge = left_edge; edge <= bottom_edge; edge++)
+		look->paint_key += QString("%1 %2;").arg(look->border_widths[edge]).arg((quintptr)look->border_colors[edge], 0, 16);
+	look->paint_key += image + ";" + pseudo_paint;
+
+	//Only the sum of border and padding matters for the geometry, so states may trade one for the other
+	look->polish_key = QString("%1 %2 %3 %4;").arg(look->border_widths[left_edge] + padding[left_edge]).arg(look->border_widths[top_edge] + padding[top_edge])
+		.arg(look->border_widths[right_edge] + padding[right_edge]).arg(look->border_widths[bottom_edge] + padding[bottom_edge]);
+	for (auto it = polish.begin(); it != polish.end(); it++)
+		look->polish_key += it.key() + ":" + it.value() + ";";
+	look->polish_key += pseudo_polish;
+
+	return look;
+}
+bool theme_style::has_inline_style(const QWidget* widget)
+{
+	//Stylesheets without selectors, like the one of the color display of styled_color_picker, are not part of the rules
+	QString style_sheet = widget->styleSheet();
+	return !style_sheet.isEmpty() && !style_sheet.contains('{');
+}
\ No newline at end of file
@@ -0,0 +1,200 @@
+/**************************************************************************************
+**
+** Copyright (C) 2016 Bernhard Steiner
+**
+** This file is part of the styled_qt_controls library
+**
+** This product is licensed under the GNU General Public License version 3.
+** The license is as published by the Free Software Foundation published at
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** Alternatively, this product is licensed under the GNU Lesser General Public
+** License version 3 for non-commercial use. The license is as published by the
+** Free Software Foundation published at https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** Feel free to contact us if you have any questions about licensing or want
+** to use the library in a commercial closed source product.
+**
+**************************************************************************************/
+
+
+#pragma once
+
+#include "..\styled_qt_controls.hpp"
+
+BEGIN_BDL_SQTC
+
+namespace util
+{
+	/*! \brief The stylesheet declarations that apply to a widget in a certain state, as resolved by theme_style
+		*
+		* \author bdl
+		*
+		* Looks are shared between all widgets in the same state and stay valid until the next stylesheet is added to theme_style.
+		*/
+	struct BDL_SQTC_EXPORT theme_style_look
+	{
+	public:
+		//! False when a rule that theme_style does not understand might apply. Nothing else in the look can be relied on in this case
+		bool exact;
+		//! True when a rule with an object name applies, False when only rules for classes apply
+		bool specific;
+		//! True when theme_style is able to paint the background, the borders and the background image described by the rules
+		bool paintable;
+		//! Background color, nullptr when the background is not filled. Points into theme_colors for "@name" colors so that theme changes are picked up
+		const QColor* background;
+		//! Colors of the left, top, right and bottom border, nullptr when the border is not drawn
+		const QColor* border_colors[4];
+		//! Widths of the left, top, right and bottom border in pixels
+		int border_widths[4];
+		//! Background image, drawn once in the center of the area inside the borders
+		QPixmap image;
+		//! Values of the qproperty- declarations, without the prefix
+		QList<QPair<QByteArray, QString>> properties;
+		//! Describes everything theme_style paints. Looks with the same key are painted identically
+		QString paint_key;
+		//! Describes everything else Qt applies when polishing a widget, e.g. the paddings, the border widths, fonts and text colors
+		QString polish_key;
+	};
+
+	/*! \brief A style that paints the backgrounds of styled controls directly from the stylesheet rules
+		*
+		* \author bdl
+		*
+		* styled_frame, styled_widget, styled_pushbutton, styled_label and styled_collapse_widget ask this style to paint their background
+		* before falling back to the stylesheet. The rules are parsed from the same stylesheet files the widgets are styled with: style_loader
+		* adds every file it loads, other stylesheets can be added with add_stylesheet. For each widget the matching rules are resolved like
+		* Qt resolves them (by specificity, then by order), and the result is cached per combination of matching rules.
+		*
+		* Only the background color, solid borders and a centered, non repeated background image are painted here. Widgets are left to
+		* QStyleSheetStyle when one of their rules uses anything else (e.g. border-radius, margins or image), when only rules without an object
+		* name apply, or when they have a stylesheet of their own without selectors. Texts, icons and frames of labels and buttons are always
+		* painted by QStyleSheetStyle, paddings and fonts are always applied by it.
+		*/
+	class BDL_SQTC_EXPORT theme_style : public QProxyStyle
+	{
+	public:
+		/*! \brief Initializes a new instance of the theme_style class
+			*
+			* \param style The style that is used for everything not covered by the rules. nullptr uses the default style of the platform
+			*/
+		theme_style(QStyle* style = nullptr);
+		/*! \brief Releases all data associated with an instance of the theme_style class
+			*/
+		virtual ~theme_style();
+
+		//! See QProxyStyle
+		virtual void drawPrimitive(PrimitiveElement element, const QStyleOption* option, QPainter* painter, const QWidget* widget = nullptr) const;
+
+		/*! \brief Enables or disables painting with theme_style
+			*
+			* The first time it is enabled, a theme_style is installed as application style. Has to be called after the QApplication has been created.
+			* Disabling it re-polishes all widgets, since style_state does not re-polish widgets while they are painted here.
+			*
+			* \param enabled True to paint matching widgets directly, False to paint everything through the stylesheets
+			*/
+		static void enabled(bool enabled);
+		/*! \brief Returns whether painting with theme_style is enabled
+			*
+			* \returns True when matching widgets are painted directly, False otherwise
+			*/
+		static bool enabled();
+
+		/*! \brief Adds the rules of a stylesheet file. Files that have already been added are skipped
+			*
+			* \param path Path to the file. Colors are written with the "@[COLOR_NAME]" syntax of style_loader
+			*/
+		static void add_file(const QString& path);
+		/*! \brief Adds the rules of a stylesheet that is not loaded with style_loader
+			*
+			* \param style_sheet The stylesheet
+			*/
+		static void add_stylesheet(const QString& style_sheet);
+
+		/*! \brief Returns the look of a widget
+			*
+			* \param widget The widget
+			* \param property Name of a property of the widget that is replaced by value, nullptr to use the current properties
+			* \param value Value used for the property
+			*
+			* \returns The look, nullptr when none of the rules can apply to the widget
+			*/
+		static const theme_style_look* look(const QWidget* widget, const char* property = nullptr, const QVariant& value = QVariant());
+		/*! \brief Returns the color of a stylesheet value
+			*
+			* \param value "@name" for a color of theme_colors, "rgb(r, g, b)", "rgba(r, g, b, a)" or anything QColor understands
+			*
+			* \returns The color, nullptr when the value is not a color
+			*/
+		static const QColor* color(const QString& value);
+
+		/*! \brief Returns whether draw_widget paints a widget with a certain look
+			*
+			* \param widget The widget
+			* \param look The look of the widget
+			*
+			* \returns True when painting with theme_style is enabled and the look can be painted, False otherwise
+			*/
+		static bool draws(const QWidget* widget, const theme_style_look* look);
+		/*! \brief Returns whether the stylesheet paints nothing but the background of a widget
+			*
+			* This is the case for styled_frame, styled_gradient_frame, styled_widget and styled_collapse_widget, and for styled_pushbutton without
+			* text, icon, menu and focus. Other subclasses are excluded, since they may paint through the stylesheet themselves.
+			*
+			* \param widget The widget
+			*
+			* \returns True when nothing is left to QStyleSheetStyle when draw_widget has painted the widget, False otherwise
+			*/
+		static bool paints_completely(const QWidget* widget);
+		/*! \brief Paints the background of a widget when painting with theme_style is enabled and the rules of the widget can be painted
+			*
+			* \param option Style option of the widget
+			* \param painter Painter used to paint the widget
+			* \param widget The widget
+			*
+			* \returns True when the background has been painted, False when the widget has to be painted by its style
+			*/
+		static bool draw_widget(const QStyleOption* option, QPainter* painter, const QWidget* widget);
+
+	private:
+		struct selector_part
+		{
+			//! Class name, empty for any class
+			QByteArray type;
+			QString id;
+			//! Names and values of the properties, a null value only requires the property to exist
+			QList<QPair<QByteArray, QString>> properties;
+			bool pseudo;
+			//! True when this part has to be the parent of the next part, False when it has to be an ancestor
+			bool child;
+		};
+		struct rule
+		{
+			QVector<selector_part> parts;
+			//! False when the selector uses something that is not understood. The rule is then assumed to apply to all widgets matching its last part
+			bool supported;
+			bool subcontrol;
+			int specificity;
+			QList<QPair<QString, QString>> declarations;
+		};
+		typedef QPair<const QMetaObject*, QString> class_name_pair;
+
+		static void parse(const QString& style_sheet);
+		static bool parse_selector(const QString& selector, rule& result);
+		static bool parse_part(const QString& text, selector_part& part, rule& result);
+		static const QVector<int>& candidates(const QWidget* widget);
+		static bool matches(const rule& r, int part, const QWidget* widget, const QWidget* subject, const char* property, const QVariant& value);
+		static theme_style_look* resolve(const QByteArray& key);
+		static bool has_inline_style(const QWidget* widget);
+
+		static QVector<rule> m_rules;
+		static QSet<QString> m_files;
+		static QHash<class_name_pair, QVector<int>> m_candidates;
+		static QHash<QByteArray, theme_style_look*> m_looks;
+		static QHash<QRgb, QColor*> m_literal_colors;
+		static bool m_enabled;
+		static bool m_installed;
+	};
+}
+
+END_BDL_SQTC
\ No newline at end of file
@@ -0,0 +1,114 @@
+/**************************************************************************************
+**
+** Copyright (C) 2016 Bernhard Steiner
+**
+** This file is part of the styled_qt_controls library
+**
+** This product is licensed under the GNU General Public License version 3.
+** The license is as published by the Free Software Foundation published at
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** Alternatively, this product is licensed under the GNU Lesser General Public
+** License version 3 for non-commercial use. The license is as published by the
+** Free Software Foundation published at https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** Feel free to contact us if you have any questions about licensing or want
+** to use the library in a commercial closed source product.
+**
+**************************************************************************************/
+
+
+#include <bdl.styled_qt_controls\styled_qt_controls.hpp>
+#include "trace_profiler.hpp"
+
+using namespace bdl::styled_qt_controls::util;
+
+bool trace_profiler::m_enabled = false;
+QString trace_profiler::m_path;
+QElapsedTimer trace_profiler::m_timer;
+QVector<trace_profiler::trace_event> trace_profiler::m_events;
+QSet<const QWidget*> trace_profiler::m_painted_widgets;
+
+void trace_profiler::start(const QString& path)
+{
+	m_path = path;
+	m_events.clear();
+	m_painted_widgets.clear();
+	m_timer.start();
+	m_enabled = true;
+}
+bool trace_profiler::stop()
+{
+	if (!m_enabled)
+		return false;
+
+	m_enabled = false;
+	m_painted_widgets.clear();
+
+	QFile file(m_path);
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+	{
+		qWarning() << "Unable to write trace file at" << m_path;
+		return false;
+	}
+
+	QTextStream stream(&file);
+	stream << "{\"traceEvents\":[\n";
+
+	qint64 pid = QCoreApplication::applicationPid();
+	for (int i = 0; i < m_events.size(); i++)
+	{
+		auto& e = m_events[i];
+		stream << "{\"name\":\"" << e.name << "\",\"cat\":\"styled_qt_controls\",\"ph\":\"X\",\"ts\":" << e.begin << ",\"dur\":" << e.duration
+			<< ",\"pid\":" << pid << ",\"tid\":1,\"args\":{\"object\":\"" << escape(e.object) << "\"}}" << (i + 1 < m_events.size() ? ",\n" : "\n");
+	}
+
+	stream << "]}\n";
+	m_events.clear();
+
+	return true;
+}
+bool trace_profiler::enabled()
+{
+	return m_enabled;
+}
+
+bool trace_profiler::first_paint(const QWidget* widget)
+{
+	if (!m_enabled || m_painted_widgets.contains(widget))
+		return false;
+
+	m_painted_widgets.insert(widget);
+	return true;
+}
+
+void trace_profiler::add_event(const char* name, const QString& object, qint64 begin, qint64 duration)
+{
+	if (!m_enabled || QThread::currentThread() != qApp->thread())
+		return;
+
+	trace_event e = { name, object, begin, duration };
+	m_events.push_back(e);
+}
+qint64 trace_profiler::now()
+{
+	return m_timer.nsecsElapsed() / 1000;
+}
+
+QString trace_profiler::escape(const QString& text)
+{
+	QString result = text;
+	return result.replace('\\', "\\\\").replace('"', "\\\"");
+}
+
+
+trace_scope::trace_scope(const char* name, const QObject* object) : m_name(trace_profiler::enabled() ? name : nullptr), m_object(object), m_begin(0)
+{
+	if (m_name != nullptr)
+		m_begin = trace_profiler::now();
+}
+trace_scope::~trace_scope()
+{
+	if (m_name != nullptr)
+		trace_profiler::add_event(m_name, m_object != nullptr ? m_object->objectName() : QString(), m_begin, trace_profiler::now() - m_begin);
+}
\ No newline at end of file
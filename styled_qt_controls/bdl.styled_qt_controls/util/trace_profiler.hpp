@@ -0,0 +1,119 @@
+/**************************************************************************************
+**
+** Copyright (C) 2016 Bernhard Steiner
+**
+** This file is part of the styled_qt_controls library
+**
+** This product is licensed under the GNU General Public License version 3.
+** The license is as published by the Free Software Foundation published at
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** Alternatively, this product is licensed under the GNU Lesser General Public
+** License version 3 for non-commercial use. The license is as published by the
+** Free Software Foundation published at https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** Feel free to contact us if you have any questions about licensing or want
+** to use the library in a commercial closed source product.
+**
+**************************************************************************************/
+
+
+#pragma once
+
+#include "..\styled_qt_controls.hpp"
+
+BEGIN_BDL_SQTC
+
+namespace util
+{
+	/*! \brief Records timings of the library in the Chrome trace event format
+		*
+		* \author bdl
+		*
+		* Recording is disabled by default, in this case each instrumented scope only costs a single check. Start recording with start and write
+		* the recorded events with stop. The resulting file can be opened with chrome://tracing. Only scopes on the GUI thread are recorded.
+		*/
+	class BDL_SQTC_EXPORT trace_profiler
+	{
+	public:
+		/*! \brief Starts recording
+			*
+			* \param path Path of the json file that is written by stop
+			*/
+		static void start(const QString& path);
+		/*! \brief Stops recording and writes all recorded events
+			*
+			* \returns True when the file has been written, False otherwise
+			*/
+		static bool stop();
+		/*! \brief Returns whether events are recorded
+			*
+			* \returns True when recording, False otherwise
+			*/
+		static bool enabled();
+
+		/*! \brief Returns whether a widget is painted for the first time since recording has been started
+			*
+			* \param widget The widget that is painted
+			*
+			* \returns True for the first call with this widget while recording, False otherwise
+			*/
+		static bool first_paint(const QWidget* widget);
+
+		/*! \brief Records an event
+			*
+			* \param name Name of the event. Has to stay valid until stop has been called (e.g. a string literal)
+			* \param object Object name of the widget the event belongs to, may be empty
+			* \param begin Start of the event in microseconds, see now
+			* \param duration Duration of the event in microseconds
+			*/
+		static void add_event(const char* name, const QString& object, qint64 begin, qint64 duration);
+		/*! \brief Returns the time since recording has been started
+			*
+			* \returns The time in microseconds
+			*/
+		static qint64 now();
+
+	private:
+		struct trace_event
+		{
+			const char* name;
+			QString object;
+			qint64 begin;
+			qint64 duration;
+		};
+
+		static QString escape(const QString& text);
+
+		static bool m_enabled;
+		static QString m_path;
+		static QElapsedTimer m_timer;
+		static QVector<trace_event> m_events;
+		static QSet<const QWidget*> m_painted_widgets;
+	};
+
+	/*! \brief Records the time between its construction and destruction as an event of the trace_profiler
+		*
+		* \author bdl
+		*/
+	class BDL_SQTC_EXPORT trace_scope
+	{
+	public:
+		/*! \brief Initializes a new instance of the trace_scope class
+			*
+			* \param name Name of the event, nullptr to record nothing. Has to stay valid until trace_profiler::stop has been called
+			* \param object Object the event belongs to, its object name is stored with the event
+			*/
+		trace_scope(const char* name, const QObject* object = nullptr);
+		/*! \brief Records the event
+			*/
+		~trace_scope();
+
+	private:
+		const char* m_name;
+		const QObject* m_object;
+		qint64 m_begin;
+	};
+}
+
+END_BDL_SQTC
\ No newline at end of file
@@ -0,0 +1,339 @@
+package theme_compiler;
+
+import java.io.BufferedReader;
+import java.io.File;
+import java.io.FileInputStream;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.InputStreamReader;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.charset.Charset;
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.LinkedHashMap;
+import java.util.Map;
+
+/**
+ * Compiles a theme file into the binary form that is loaded by style_loader::load_theme
+ *
+ * A theme file consists of a [colors] section with "name = #rrggbb" or "name = #aarrggbb" lines and
+ * a [stylesheets] section with "resource_path = file" lines, where file is relative to the theme file.
+ * Lines starting with ';' are comments.
+ *
+ * The binary form (little endian) starts with the magic "SQTT", the version, the number of colors and
+ * the number of stylesheets. It is followed by the color entries (name offset, name length, argb),
+ * the stylesheet entries (path offset, path length, text offset, text length) and a pool of
+ * deduplicated UTF-16 strings. Offsets are in bytes from the start of the file, lengths in characters.
+ * All @color tokens in the stylesheets are already substituted.
+ *
+ * Optionally the colors are also written as C++ definitions of the theme_colors members, so the
+ * default colors of the library are taken from the same theme file.
+ *
+ * @author bdl
+ */
+public class Theme_compiler {
+
+    static final int VERSION = 1;
+
+    static String theme_path;
+    static String output_path;
+    static String colors_path;
+
+    static LinkedHashMap<String, Integer> colors = new LinkedHashMap<>();
+    static LinkedHashMap<String, File> stylesheets = new LinkedHashMap<>();
+
+    public static void main(String[] args) {
+
+        if (args.length != 2 && args.length != 3)
+        {
+            System.out.print("USAGE: theme_compiler [THEME_FILE] [OUTPUT_FILE] [COLORS_FILE (optional)]");
+            System.exit(-1);
+        }
+
+        try
+        {
+            System.out.print("theme_compiler: Checking theme");
+
+            theme_path = args[0];
+            output_path = args[1];
+            colors_path = args.length == 3 ? args[2] : null;
+
+            read_theme();
+
+            if (need_compile())
+            {
+                compile_theme();
+                if (colors_path != null)
+                    write_colors();
+                System.out.println("... updated theme file!");
+            }
+            else
+                System.out.println("... nothing to do!");
+        }
+        catch (Exception e)
+        {
+            System.out.println("\nUnknown exception caught: " + e.getMessage());
+            e.printStackTrace();
+            System.exit(-1);
+        }
+    }
+
+    static void read_theme() throws IOException
+    {
+        File theme_file = new File(theme_path);
+        String section = "";
+        int line_number = 0;
+
+        for (String line : read_lines(theme_file))
+        {
+            line_number++;
+            line = line.trim();
+            if (line.isEmpty() || line.startsWith(";"))
+                continue;
+
+            if (line.startsWith("[") && line.endsWith("]"))
+            {
+                section = line.substring(1, line.length() - 1).trim();
+                continue;
+            }
+
+            int separator = line.indexOf('=');
+            if (separator < 0)
+                fail(theme_path + "(" + line_number + "): expected \"name = value\"");
+
+            String name = line.substring(0, separator).trim();
+            String value = line.substring(separator + 1).trim();
+
+            if (section.equals("colors"))
+                colors.put(name, parse_color(value, line_number));
+            else if (section.equals("stylesheets"))
+                stylesheets.put(name, new File(theme_file.getAbsoluteFile().getParentFile(), value));
+            else
+                fail(theme_path + "(" + line_number + "): entry outside of [colors] or [stylesheets]");
+        }
+    }
+
+    static boolean need_compile()
+    {
+        File output_file = new File(output_path);
+        if (!output_file.exists())
+            return true;
+
+        long ref_date = output_file.lastModified();
+        if (colors_path != null)
+        {
+            File colors_file = new File(colors_path);
+            if (!colors_file.exists())
+                return true;
+            ref_date = Math.min(ref_date, colors_file.lastModified());
+        }
+
+        if (new File(theme_path).lastModified() > ref_date)
+            return true;
+
+        for (File f : stylesheets.values())
+        {
+            if (f.lastModified() > ref_date)
+                return true;
+        }
+
+        return false;
+    }
+
+    static void compile_theme() throws IOException
+    {
+        //Strings are deduplicated, identical fragments are only stored once
+        ArrayList<String> pool = new ArrayList<>();
+        HashMap<String, Integer> pool_indices = new HashMap<>();
+
+        ArrayList<int[]> color_entries = new ArrayList<>();
+        for (Map.Entry<String, Integer> color : colors.entrySet())
+            color_entries.add(new int[] { add_string(pool, pool_indices, color.getKey()), color.getValue() });
+
+        ArrayList<int[]> style_entries = new ArrayList<>();
+        for (Map.Entry<String, File> stylesheet : stylesheets.entrySet())
+        {
+            String text = replace_colors(read_text(stylesheet.getValue()), stylesheet.getValue().getPath());
+            style_entries.add(new int[] { add_string(pool, pool_indices, stylesheet.getKey()), add_string(pool, pool_indices, text) });
+        }
+
+        //Compute the offsets of all strings in the pool
+        int header_size = 16 + color_entries.size() * 12 + style_entries.size() * 16;
+        int[] offsets = new int[pool.size()];
+        int size = header_size;
+        for (int i = 0; i < pool.size(); i++)
+        {
+            offsets[i] = size;
+            size += pool.get(i).length() * 2;
+        }
+
+        ByteBuffer buffer = ByteBuffer.allocate(size).order(ByteOrder.LITTLE_ENDIAN);
+        buffer.put("SQTT".getBytes(Charset.forName("US-ASCII")));
+        buffer.putInt(VERSION);
+        buffer.putInt(color_entries.size());
+        buffer.putInt(style_entries.size());
+
+        for (int[] entry : color_entries)
+        {
+            buffer.putInt(offsets[entry[0]]);
+            buffer.putInt(pool.get(entry[0]).length());
+            buffer.putInt(entry[1]);
+        }
+        for (int[] entry : style_entries)
+        {
+            buffer.putInt(offsets[entry[0]]);
+            buffer.putInt(pool.get(entry[0]).length());
+            buffer.putInt(offsets[entry[1]]);
+            buffer.putInt(pool.get(entry[1]).length());
+        }
+        for (String s : pool)
+            buffer.put(s.getBytes(Charset.forName("UTF-16LE")));
+
+        File output_file = new File(output_path).getAbsoluteFile();
+        output_file.getParentFile().mkdirs();
+        FileOutputStream output = new FileOutputStream(output_file);
+        try
+        {
+            output.write(buffer.array());
+        }
+        finally
+        {
+            output.close();
+        }
+    }
+
+    //Writes the definitions of the theme_colors members, included by theme_colors.cpp
+    static void write_colors() throws IOException
+    {
+        StringBuilder text = new StringBuilder();
+        text.append("//Generated by tools/theme_compiler from ").append(new File(theme_path).getName()).append(". Do not edit, change the theme file instead\r\n\r\n");
+
+        for (Map.Entry<String, Integer> color : colors.entrySet())
+        {
+            int argb = color.getValue();
+            text.append("QColor theme_colors::").append(color.getKey()).append("(")
+                .append((argb >> 16) & 0xff).append(", ").append((argb >> 8) & 0xff).append(", ").append(argb & 0xff).append(", ").append((argb >>> 24) & 0xff)
+                .append(");\r\n");
+        }
+
+        FileOutputStream output = new FileOutputStream(colors_path);
+        try
+        {
+            output.write(text.toString().getBytes(Charset.forName("UTF-8")));
+        }
+        finally
+        {
+            output.close();
+        }
+    }
+
+    static int add_string(ArrayList<String> pool, HashMap<String, Integer> pool_indices, String s)
+    {
+        Integer index = pool_indices.get(s);
+        if (index == null)
+        {
+            index = pool.size();
+            pool.add(s);
+            pool_indices.put(s, index);
+        }
+        return index;
+    }
+
+    static String replace_colors(String text, String path)
+    {
+        StringBuilder result = new StringBuilder(text.length() + text.length() / 4);
+        int line = 1;
+        int line_start = 0;
+
+        for (int i = 0; i < text.length(); i++)
+        {
+            char c = text.charAt(i);
+            if (c == '\n')
+            {
+                line++;
+                line_start = i + 1;
+            }
+            else if (c == '@')
+            {
+                int end = i + 1;
+                while (end < text.length() && (Character.isLetterOrDigit(text.charAt(end)) || text.charAt(end) == '_'))
+                    end++;
+
+                String name = text.substring(i + 1, end);
+                Integer argb = colors.get(name);
+                if (argb == null)
+                    fail(path + "(" + line + "," + (i - line_start + 1) + "): unknown color @" + name);
+
+                result.append(color_to_text(argb));
+                i = end - 1;
+                continue;
+            }
+
+            result.append(c);
+        }
+
+        return result.toString();
+    }
+
+    //Has to produce the same text as style_loader::color_to_text
+    static String color_to_text(int argb)
+    {
+        return "rgba(" + ((argb >> 16) & 0xff) + ", " + ((argb >> 8) & 0xff) + ", " + (argb & 0xff) + ", " + ((argb >>> 24) & 0xff) + ")";
+    }
+
+    static int parse_color(String value, int line_number)
+    {
+        if (value.startsWith("#") && (value.length() == 7 || value.length() == 9))
+        {
+            //Long.parseLong would accept a sign as well, so every digit is checked
+            int color = 0;
+            int i = 1;
+            for (; i < value.length(); i++)
+            {
+                char c = value.charAt(i);
+                int digit = c < 128 ? Character.digit(c, 16) : -1;
+                if (digit < 0)
+                    break;
+                color = color * 16 + digit;
+            }
+
+            if (i == value.length())
+                return value.length() == 7 ? (color | 0xff000000) : color;
+        }
+
+        fail(theme_path + "(" + line_number + "): invalid color \"" + value + "\", expected #rrggbb or #aarrggbb");
+        return 0;
+    }
+
+    static ArrayList<String> read_lines(File f) throws IOException
+    {
+        ArrayList<String> lines = new ArrayList<>();
+        BufferedReader reader = new BufferedReader(new InputStreamReader(new FileInputStream(f), Charset.forName("UTF-8")));
+        try
+        {
+            String s;
+            while ((s = reader.readLine()) != null)
+                lines.add(s);
+        }
+        finally
+        {
+            reader.close();
+        }
+        return lines;
+    }
+
+    static String read_text(File f) throws IOException
+    {
+        StringBuilder text = new StringBuilder();
+        for (String line : read_lines(f))
+            text.append(line).append('\n');
+        return text.toString();
+    }
+
+    static void fail(String message)
+    {
+        System.out.println("\n" + message);
+        System.exit(-1);
+    }
+}